@@ -0,0 +1,129 @@
+/** @file ArrayStack.cpp
+ * ArrayStack creates a stack using an inline buffer that grows into a contiguous heap array.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ArrayStack.h"
+#include "PrecondViolatedExcept.h"
+
+// Default constructor initializes the stack as empty, using the inline buffer.
+template<class ItemType, std::size_t InlineCapacity>
+ArrayStack<ItemType, InlineCapacity>::ArrayStack()
+    : items(inlineItems), itemCount(0), capacity(InlineCapacity)
+{ } // end default constructor
+
+// Copy constructor that copies the items of the original stack.
+template<class ItemType, std::size_t InlineCapacity>
+ArrayStack<ItemType, InlineCapacity>::ArrayStack(const ArrayStack<ItemType, InlineCapacity>& originalStack)
+    : ArrayStack()
+{
+    *this = originalStack;
+} // end copy constructor
+
+// Copy assignment that copies the items of the original stack, growing the storage if needed.
+template<class ItemType, std::size_t InlineCapacity>
+ArrayStack<ItemType, InlineCapacity>& ArrayStack<ItemType, InlineCapacity>::operator=(
+    const ArrayStack<ItemType, InlineCapacity>& originalStack)
+{
+    if (this != &originalStack)
+    {
+        itemCount = 0;
+        while (capacity < originalStack.itemCount)
+        {
+            grow();
+        }
+        for (std::size_t i = 0; i < originalStack.itemCount; ++i)
+        {
+            items[i] = originalStack.items[i];
+        }
+        itemCount = originalStack.itemCount;
+    }
+    return *this;
+} // end operator=
+
+// Destructor. The heap array, if any, is released by its smart pointer.
+template<class ItemType, std::size_t InlineCapacity>
+ArrayStack<ItemType, InlineCapacity>::~ArrayStack()
+{ } // end destructor
+
+// Doubles the capacity and moves the items into the new heap array.
+template<class ItemType, std::size_t InlineCapacity>
+void ArrayStack<ItemType, InlineCapacity>::grow()
+{
+    std::size_t newCapacity = capacity == 0 ? 1 : capacity * 2;
+    std::unique_ptr<ItemType[]> newItems(new ItemType[newCapacity]);
+
+    for (std::size_t i = 0; i < itemCount; ++i)
+    {
+        newItems[i] = items[i];
+    }
+
+    heapItems = std::move(newItems);
+    items = heapItems.get();
+    capacity = newCapacity;
+} // end grow
+
+// Checks if the stack is empty.
+template<class ItemType, std::size_t InlineCapacity>
+bool ArrayStack<ItemType, InlineCapacity>::isEmpty() const noexcept
+{
+    return itemCount == 0;
+} // end isEmpty
+
+// Pushes an item onto the top of the stack.
+template<class ItemType, std::size_t InlineCapacity>
+bool ArrayStack<ItemType, InlineCapacity>::push(const ItemType& someItem) noexcept
+{
+    if (itemCount == capacity)
+    {
+        try
+        {
+            grow();  // Amortized growth keeps push constant time on average
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;  // Stack is unchanged
+        }
+    }
+
+    items[itemCount++] = someItem;
+    return true;
+} // end push
+
+// Pops (removes) the item at the top of the stack.
+template<class ItemType, std::size_t InlineCapacity>
+bool ArrayStack<ItemType, InlineCapacity>::pop() noexcept
+{
+    if (!isEmpty())
+    {
+        --itemCount;
+        return true;
+    }
+    return false;  // Stack was empty, nothing to pop
+} // end pop
+
+// Retrieves the item at the top of the stack without removing it.
+template<class ItemType, std::size_t InlineCapacity>
+ItemType ArrayStack<ItemType, InlineCapacity>::peek() const
+{
+    // Check if the stack is empty before peeking
+    if (isEmpty())
+        throw PrecondViolatedExcept("peek() called with empty stack.");
+
+    return items[itemCount - 1];  // Return the item at the top of the stack
+} // end peek
+
+// Clears all items from the stack, keeping the storage for reuse.
+template<class ItemType, std::size_t InlineCapacity>
+void ArrayStack<ItemType, InlineCapacity>::clear()
+{
+    itemCount = 0;
+} // end clear
+
+// Gets the number of items in the stack.
+template<class ItemType, std::size_t InlineCapacity>
+std::size_t ArrayStack<ItemType, InlineCapacity>::size() const noexcept
+{
+    return itemCount;
+} // end size
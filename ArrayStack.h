@@ -0,0 +1,96 @@
+/** @file ArrayStack.h
+ * @class ArrayStack
+ * Implements a stack using contiguous storage and inherits from StackInterface. Up to InlineCapacity items are
+ * kept in a buffer inside the stack itself, so small stacks never allocate. Larger stacks move to a heap array
+ * that doubles in size when full. */
+
+#ifndef ARRAY_STACK_
+#define ARRAY_STACK_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include "StackInterface.h"
+
+template<class ItemType, std::size_t InlineCapacity = 16>
+class ArrayStack : public StackInterface<ItemType>
+{
+private:
+    /** Storage used while the stack holds at most InlineCapacity items. */
+    ItemType inlineItems[InlineCapacity];
+
+    /** Storage used once the stack has outgrown the inline buffer. */
+    std::unique_ptr<ItemType[]> heapItems;
+
+    /** Pointer to the storage in use, either inlineItems or heapItems. */
+    ItemType* items;
+
+    /** Number of items in the stack. */
+    std::size_t itemCount;
+
+    /** Number of items the storage in use can hold. */
+    std::size_t capacity;
+
+    /** Doubles the capacity of the stack, moving the items to a larger heap array.
+     * @throws std::bad_alloc If the larger array cannot be allocated. */
+    void grow();
+
+public:
+    /** Default constructor
+     * Initializes the stack to be empty, using the inline buffer. */
+    ArrayStack();
+
+    /** Copy constructor
+     * Creates a copy of another ArrayStack.
+     * @param originalStack The stack to be copied. */
+    ArrayStack(const ArrayStack<ItemType, InlineCapacity>& originalStack);
+
+    /** Copy assignment operator
+     * Replaces the items of this stack with copies of the items of another ArrayStack.
+     * @param originalStack The stack to be copied.
+     * @return A reference to this stack. */
+    ArrayStack<ItemType, InlineCapacity>& operator=(const ArrayStack<ItemType, InlineCapacity>& originalStack);
+
+    /** Destructor */
+    virtual ~ArrayStack();
+
+    /** Checks if the stack is empty.
+     * @pre None
+     * @post Does not change the stack
+     * @return True if the stack is empty, false otherwise. */
+    bool isEmpty() const noexcept override;
+
+    /** Adds a new entry to the top of this stack.
+     * @pre None
+     * @post If the operation was successful, someItem is at the top of the stack.
+     * @param someItem The object to be added as a new entry.
+     * @return True if the addition is successful, or false if the stack could not grow. */
+    bool push(const ItemType& someItem) noexcept override;
+
+    /** Removes the top of this stack.
+     * @pre None
+     * @post If the operation was successful, the top of the stack has been removed.
+     * @return True if the removal is successful, or false if not. */
+    bool pop() noexcept override;
+
+    /** Retrieves a copy of the top item of this stack.
+     * @pre The stack is not empty.
+     * @post A copy of the top item is returned, and the stack remains unchanged.
+     * @return A copy of the top item of the stack.
+     * @throws PrecondViolatedExcept if the stack is empty. */
+    ItemType peek() const override;
+
+    /** Clears all items from the stack. Storage is kept for reuse.
+     * @pre None
+     * @post The stack is empty. */
+    void clear() final override;
+
+    /** Gets the number of items in the stack.
+     * @pre None
+     * @post Does not change the stack.
+     * @return The number of items in the stack. */
+    std::size_t size() const noexcept;
+}; // end ArrayStack
+
+#include "ArrayStack.cpp"
+#endif
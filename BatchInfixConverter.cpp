@@ -0,0 +1,200 @@
+/** @file BatchInfixConverter.cpp
+ * BatchInfixConverter converts buffers of newline-separated infix expressions into one arena of postfix text.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "BatchInfixConverter.h"
+
+constexpr BatchInfixConverter::CharacterTables::CharacterTables() noexcept : classes{}, lowercase{}
+{
+    for (int character = 0; character < 256; ++character)
+    {
+        CharacterClass characterClass = CharacterClass::Other;
+        if (character == ' ' || (character >= '\t' && character <= '\r')) characterClass = CharacterClass::Space;
+        else if ((character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z')) characterClass = CharacterClass::Letter;
+        else if (character >= '0' && character <= '9') characterClass = CharacterClass::Digit;
+        else if (character == '.') characterClass = CharacterClass::Dot;
+        else if (character == '_') characterClass = CharacterClass::Underscore;
+        else if (character == '+' || character == '-' || character == '*' || character == '/') characterClass = CharacterClass::Operator;
+        else if (character == '(') characterClass = CharacterClass::LeftParenthesis;
+        else if (character == ')') characterClass = CharacterClass::RightParenthesis;
+        classes[character] = characterClass;
+        lowercase[character] = static_cast<char>(character >= 'A' && character <= 'Z' ? character - 'A' + 'a' : character);
+    }
+} // end constructor
+
+const BatchInfixConverter::CharacterTables BatchInfixConverter::TABLES;  // Constant-initialized, no startup cost
+
+BatchInfixConverter::CharacterClass BatchInfixConverter::classify(char character) noexcept
+{
+    return TABLES.classes[static_cast<unsigned char>(character)];
+} // end classify
+
+void BatchInfixConverter::convertLine(std::string_view line)
+{
+    std::size_t start = arena.size();
+    bool spaced = false;  // As in convertInfixToPostfix, spaces are only kept if a token is longer than one character
+    bool balanced = true;
+    std::size_t operandCount = 0;
+    bool hasOperator = false;
+    operatorStack.clear();
+    const char* position = line.data();
+    const char* lineEnd = line.data() + line.size();
+
+    while (position < lineEnd)
+    {
+        CharacterClass characterClass = classify(*position);
+        const char* tokenStart = position;
+
+        if (characterClass == CharacterClass::Letter)  // Variable name
+        {
+            ++position;
+            while (position < lineEnd)
+            {
+                CharacterClass nextClass = classify(*position);
+                if (nextClass != CharacterClass::Letter && nextClass != CharacterClass::Digit &&
+                    nextClass != CharacterClass::Underscore)
+                {
+                    break;
+                }
+                ++position;
+            }
+        }
+        else if (characterClass == CharacterClass::Digit || (characterClass == CharacterClass::Dot &&
+            position + 1 < lineEnd && classify(position[1]) == CharacterClass::Digit))  // Literal
+        {
+            // Same extent as ExpressionTokenizer: the longest number from_chars reads
+            double value = 0;
+            std::from_chars_result parsed = std::from_chars(position, lineEnd, value, std::chars_format::general);
+            position = parsed.ptr == position ? position + 1 : parsed.ptr;
+            if (parsed.ec != std::errc()) continue;  // Out of range literals are ignored like other invalid tokens
+        }
+        else
+        {
+            ++position;
+            switch (characterClass)
+            {
+            case CharacterClass::Operator:
+                hasOperator = true;
+                while (!operatorStack.empty() && operatorStack.back() != '(' &&
+                    PostfixProgram::precedence(*tokenStart) <= PostfixProgram::precedence(operatorStack.back()))
+                {
+                    arena += operatorStack.back();
+                    arena += ' ';
+                    operatorStack.pop_back();
+                }
+                operatorStack.push_back(*tokenStart);
+                break;
+            case CharacterClass::LeftParenthesis:
+                operatorStack.push_back('(');
+                break;
+            case CharacterClass::RightParenthesis:
+                while (!operatorStack.empty() && operatorStack.back() != '(')
+                {
+                    arena += operatorStack.back();
+                    arena += ' ';
+                    operatorStack.pop_back();
+                }
+                if (operatorStack.empty()) balanced = false;
+                else operatorStack.pop_back();  // Remove the open parenthesis
+                break;
+            default:  // Whitespace and other characters
+                break;
+            }
+            continue;
+        }
+
+        // Operand: copy it in lowercase, followed by a space
+        for (const char* operandChar = tokenStart; operandChar < position; ++operandChar)
+        {
+            arena += TABLES.lowercase[static_cast<unsigned char>(*operandChar)];
+        }
+        arena += ' ';
+        if (position - tokenStart > 1) spaced = true;
+        ++operandCount;
+    }
+
+    // Add remaining operators to postfix expression
+    while (!operatorStack.empty())
+    {
+        arena += operatorStack.back();
+        arena += ' ';
+        operatorStack.pop_back();
+    }
+
+    if (operandCount > 1 && !hasOperator) spaced = true;  // Compact operands with no operator would merge
+    if (spaced)
+    {
+        if (arena.size() > start) arena.pop_back();  // Drop the space after the last token
+    }
+    else  // Compact form: squeeze the spaces out in place
+    {
+        std::size_t written = start;
+        for (std::size_t i = start; i < arena.size(); ++i)
+        {
+            if (arena[i] != ' ') arena[written++] = arena[i];
+        }
+        arena.resize(written);
+    }
+    offsets.push_back(arena.size());
+    balancedLines.push_back(balanced);
+} // end convertLine
+
+std::size_t BatchInfixConverter::convert(std::string_view buffer)
+{
+    arena.clear();
+    offsets.clear();
+    balancedLines.clear();
+    arena.reserve(buffer.size() + buffer.size() / 2);  // Room for the spaces of spaced expressions
+    offsets.push_back(0);
+
+    const char* position = buffer.data();
+    const char* bufferEnd = buffer.data() + buffer.size();
+    while (position < bufferEnd)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', static_cast<std::size_t>(bufferEnd - position)));
+        if (lineEnd == nullptr) lineEnd = bufferEnd;
+        std::size_t length = static_cast<std::size_t>(lineEnd - position);
+        if (length > 0 && position[length - 1] == '\r') --length;  // Accept Windows line endings
+        convertLine(std::string_view(position, length));
+        position = lineEnd + 1;
+    }
+    return size();
+} // end convert
+
+std::size_t BatchInfixConverter::size() const noexcept
+{
+    return offsets.empty() ? 0 : offsets.size() - 1;
+} // end size
+
+std::string_view BatchInfixConverter::getPostfix(std::size_t index) const
+{
+    if (index >= size())
+    {
+        throw PrecondViolatedExcept("getPostfix() called with an invalid expression index.");
+    }
+    return std::string_view(arena).substr(offsets[index], offsets[index + 1] - offsets[index]);
+} // end getPostfix
+
+std::string_view BatchInfixConverter::getArena() const noexcept
+{
+    return arena;
+} // end getArena
+
+const std::vector<std::size_t>& BatchInfixConverter::getOffsets() const noexcept
+{
+    return offsets;
+} // end getOffsets
+
+std::shared_ptr<const PostfixProgram> BatchInfixConverter::compile(std::size_t index,
+    std::shared_ptr<SymbolTable> symbols) const
+{
+    std::string postfixExpression(getPostfix(index));
+    if (!balancedLines[index])  // No instructions, so every evaluation reports an invalid expression
+    {
+        return std::make_shared<const PostfixProgram>(std::vector<PostfixProgram::Instruction>(),
+            std::vector<double>(), 0, std::move(postfixExpression), std::move(symbols));
+    }
+    return std::make_shared<const PostfixProgram>(std::move(postfixExpression), std::move(symbols));
+} // end compile
@@ -0,0 +1,134 @@
+/** @file BatchInfixConverter.h
+ * @class BatchInfixConverter
+ * Converts a whole buffer of newline-separated infix expressions to postfix in one call, for ingesting files of
+ * formulas. Lines are found with memchr and characters are classified and lowercased through 256-entry tables
+ * instead of the locale-aware <cctype> functions. Every postfix expression is written into one contiguous arena
+ * with an index of offsets, so once the arena and the operator stack have grown to fit, a conversion allocates
+ * nothing per expression. The postfix text of each line is the same as getPostfixExpression() gives after
+ * convertInfixToPostfix of that line. */
+
+#ifndef BATCH_INFIX_CONVERTER_
+#define BATCH_INFIX_CONVERTER_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "PostfixProgram.h"
+#include "SymbolTable.h"
+#include "PrecondViolatedExcept.h"
+
+class BatchInfixConverter
+{
+private:
+    /** Classes of input characters. */
+    enum class CharacterClass : std::uint8_t
+    {
+        Space,             // Whitespace, which separates tokens
+        Letter,            // Starts a variable name
+        Digit,             // Starts a literal and continues a name
+        Dot,               // Starts a literal if a digit follows
+        Underscore,        // Continues a name
+        Operator,          // One of +,-,*,/
+        LeftParenthesis,
+        RightParenthesis,
+        Other              // Ignored, like Invalid tokens of ExpressionTokenizer
+    };
+
+    /** Lookup tables indexed by byte value, filled at compile time. */
+    struct CharacterTables
+    {
+        /** Class of every byte, the same as the "C" locale gives for isspace, isalpha and isdigit. */
+        CharacterClass classes[256];
+
+        /** Lowercase form of every byte. */
+        char lowercase[256];
+
+        /** Fills both tables. */
+        constexpr CharacterTables() noexcept;
+    };
+
+    /** The lookup tables. */
+    static const CharacterTables TABLES;
+
+    /** All postfix expressions, one after another without separators. */
+    std::string arena;
+
+    /** Offset of each postfix expression in the arena, followed by the end of the last. */
+    std::vector<std::size_t> offsets;
+
+    /** Whether each expression has an opening parenthesis for every closing one. */
+    std::vector<bool> balancedLines;
+
+    /** Operators and open parentheses waiting to be output, reused by every expression. */
+    std::vector<char> operatorStack;
+
+    /** Gets the class of a character.
+     * @param character The character.
+     * @return Its class. */
+    static CharacterClass classify(char character) noexcept;
+
+    /** Converts one line and appends its postfix text to the arena.
+     * @pre None
+     * @post The postfix text is at the end of the arena.
+     * @param line The infix expression, without its newline. */
+    void convertLine(std::string_view line);
+
+public:
+    /** Default constructor. Creates a converter holding no expressions. */
+    BatchInfixConverter() = default;
+
+    /** Converts every line of a buffer, replacing the expressions of the previous call. A line ends at '\n', and a
+     * '\r' before it is dropped. Blank lines give empty postfix expressions so indices match line numbers; a
+     * newline at the very end of the buffer does not start another line. A closing parenthesis with no opening
+     * one is left out of the postfix text, and compile() gives an invalid program for its line.
+     * @pre None
+     * @post The converter holds one postfix expression per line.
+     * @param buffer The infix expressions.
+     * @return The number of expressions converted.
+     * @throws std::bad_alloc If the arena cannot grow. */
+    std::size_t convert(std::string_view buffer);
+
+    /** Gets the number of expressions converted by the last call.
+     * @pre None
+     * @post None
+     * @return The number of expressions. */
+    std::size_t size() const noexcept;
+
+    /** Gets a postfix expression without copying it.
+     * @pre None
+     * @post None
+     * @param index The line number of the expression, from 0.
+     * @return A view of the postfix text, valid until the next conversion.
+     * @throws PrecondViolatedExcept If index is out of range. */
+    std::string_view getPostfix(std::size_t index) const;
+
+    /** Gets the arena holding every postfix expression.
+     * @pre None
+     * @post None
+     * @return The arena; expression i runs from getOffsets()[i] to getOffsets()[i + 1]. */
+    std::string_view getArena() const noexcept;
+
+    /** Gets the index of the arena.
+     * @pre None
+     * @post None
+     * @return size() + 1 offsets. */
+    const std::vector<std::size_t>& getOffsets() const noexcept;
+
+    /** Compiles one of the postfix expressions into a program, the same one convertInfixToPostfix compiles for
+     * the line before optimization.
+     * @pre None
+     * @post None
+     * @param index The line number of the expression, from 0.
+     * @param symbols The table that assigns slots to variable names past a-f.
+     * @return The compiled program.
+     * @throws PrecondViolatedExcept If index is out of range. */
+    std::shared_ptr<const PostfixProgram> compile(std::size_t index, std::shared_ptr<SymbolTable> symbols) const;
+}; // end BatchInfixConverter
+
+#include "BatchInfixConverter.cpp"
+#endif
@@ -0,0 +1,262 @@
+/** @file BatchKernels.cpp
+ * BatchKernels implements the scalar and SIMD kernels for batch evaluation and picks one set at runtime.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "BatchKernels.h"
+
+void BatchKernels::addScalar(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) result[i] = lhs[i] + rhs[i];
+} // end addScalar
+
+void BatchKernels::subtractScalar(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) result[i] = lhs[i] - rhs[i];
+} // end subtractScalar
+
+void BatchKernels::multiplyScalar(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) result[i] = lhs[i] * rhs[i];
+} // end multiplyScalar
+
+void BatchKernels::divideScalar(const double* lhs, const double* rhs, double* result, std::size_t count,
+    std::uint64_t zeroMask[])
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (rhs[i] == 0) zeroMask[i / 64] |= std::uint64_t(1) << (i % 64);  // Flag the lane instead of throwing
+        result[i] = lhs[i] / rhs[i];
+    }
+} // end divideScalar
+
+#ifdef POSTFIX_X86_KERNELS
+
+// SSE2 kernels process two lanes per instruction
+POSTFIX_TARGET("sse2")
+void BatchKernels::addSSE2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(result + i, _mm_add_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    addScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end addSSE2
+
+POSTFIX_TARGET("sse2")
+void BatchKernels::subtractSSE2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(result + i, _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    subtractScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end subtractSSE2
+
+POSTFIX_TARGET("sse2")
+void BatchKernels::multiplySSE2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(result + i, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    multiplyScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end multiplySSE2
+
+POSTFIX_TARGET("sse2")
+void BatchKernels::divideSSE2(const double* lhs, const double* rhs, double* result, std::size_t count,
+    std::uint64_t zeroMask[])
+{
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d divisor = _mm_loadu_pd(rhs + i);
+        std::uint64_t lanes = static_cast<std::uint64_t>(_mm_movemask_pd(_mm_cmpeq_pd(divisor, zero)));
+        zeroMask[i / 64] |= lanes << (i % 64);
+        _mm_storeu_pd(result + i, _mm_div_pd(_mm_loadu_pd(lhs + i), divisor));
+    }
+    for (; i < count; ++i)  // Remaining lanes
+    {
+        if (rhs[i] == 0) zeroMask[i / 64] |= std::uint64_t(1) << (i % 64);
+        result[i] = lhs[i] / rhs[i];
+    }
+} // end divideSSE2
+
+// AVX2 kernels process four lanes per instruction
+POSTFIX_TARGET("avx2")
+void BatchKernels::addAVX2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(result + i, _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    addScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end addAVX2
+
+POSTFIX_TARGET("avx2")
+void BatchKernels::subtractAVX2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(result + i, _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    subtractScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end subtractAVX2
+
+POSTFIX_TARGET("avx2")
+void BatchKernels::multiplyAVX2(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(result + i, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    multiplyScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end multiplyAVX2
+
+POSTFIX_TARGET("avx2")
+void BatchKernels::divideAVX2(const double* lhs, const double* rhs, double* result, std::size_t count,
+    std::uint64_t zeroMask[])
+{
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d divisor = _mm256_loadu_pd(rhs + i);
+        std::uint64_t lanes = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(divisor, zero, _CMP_EQ_OQ)));
+        zeroMask[i / 64] |= lanes << (i % 64);
+        _mm256_storeu_pd(result + i, _mm256_div_pd(_mm256_loadu_pd(lhs + i), divisor));
+    }
+    for (; i < count; ++i)  // Remaining lanes
+    {
+        if (rhs[i] == 0) zeroMask[i / 64] |= std::uint64_t(1) << (i % 64);
+        result[i] = lhs[i] / rhs[i];
+    }
+} // end divideAVX2
+
+// AVX-512 kernels process eight lanes per instruction
+POSTFIX_TARGET("avx512f")
+void BatchKernels::addAVX512(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm512_storeu_pd(result + i, _mm512_add_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+    }
+    addScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end addAVX512
+
+POSTFIX_TARGET("avx512f")
+void BatchKernels::subtractAVX512(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm512_storeu_pd(result + i, _mm512_sub_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+    }
+    subtractScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end subtractAVX512
+
+POSTFIX_TARGET("avx512f")
+void BatchKernels::multiplyAVX512(const double* lhs, const double* rhs, double* result, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm512_storeu_pd(result + i, _mm512_mul_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+    }
+    multiplyScalar(lhs + i, rhs + i, result + i, count - i);  // Remaining lanes
+} // end multiplyAVX512
+
+POSTFIX_TARGET("avx512f")
+void BatchKernels::divideAVX512(const double* lhs, const double* rhs, double* result, std::size_t count,
+    std::uint64_t zeroMask[])
+{
+    const __m512d zero = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d divisor = _mm512_loadu_pd(rhs + i);
+        std::uint64_t lanes = static_cast<std::uint64_t>(_mm512_cmp_pd_mask(divisor, zero, _CMP_EQ_OQ));
+        zeroMask[i / 64] |= lanes << (i % 64);
+        _mm512_storeu_pd(result + i, _mm512_div_pd(_mm512_loadu_pd(lhs + i), divisor));
+    }
+    for (; i < count; ++i)  // Remaining lanes
+    {
+        if (rhs[i] == 0) zeroMask[i / 64] |= std::uint64_t(1) << (i % 64);
+        result[i] = lhs[i] / rhs[i];
+    }
+} // end divideAVX512
+
+#endif // POSTFIX_X86_KERNELS
+
+BatchKernels::Level BatchKernels::detectLevel() noexcept
+{
+#if defined(POSTFIX_X86_KERNELS) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int highestLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool hasSSE2 = (info[3] & (1 << 26)) != 0;
+    bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+    bool hasAVX = (info[2] & (1 << 28)) != 0;
+    if (!hasSSE2) return Level::Scalar;
+    if (!hasOSXSave || !hasAVX || highestLeaf < 7) return Level::SSE2;
+
+    // The operating system must save the wider registers on context switches
+    unsigned long long enabledState = _xgetbv(0);
+    if ((enabledState & 0x6) != 0x6) return Level::SSE2;
+
+    __cpuidex(info, 7, 0);
+    bool hasAVX2 = (info[1] & (1 << 5)) != 0;
+    bool hasAVX512 = (info[1] & (1 << 16)) != 0 && (enabledState & 0xE6) == 0xE6;
+    if (hasAVX512) return Level::AVX512;
+    if (hasAVX2) return Level::AVX2;
+    return Level::SSE2;
+#elif defined(POSTFIX_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Level::SSE2;
+    return Level::Scalar;
+#else
+    return Level::Scalar;
+#endif
+} // end detectLevel
+
+const BatchKernels::KernelTable& BatchKernels::select(Level maximumLevel) noexcept
+{
+    static const KernelTable scalarTable = { Level::Scalar, "scalar", addScalar, subtractScalar, multiplyScalar, divideScalar };
+#ifdef POSTFIX_X86_KERNELS
+    static const KernelTable sse2Table = { Level::SSE2, "sse2", addSSE2, subtractSSE2, multiplySSE2, divideSSE2 };
+    static const KernelTable avx2Table = { Level::AVX2, "avx2", addAVX2, subtractAVX2, multiplyAVX2, divideAVX2 };
+    static const KernelTable avx512Table = { Level::AVX512, "avx512", addAVX512, subtractAVX512, multiplyAVX512, divideAVX512 };
+#endif
+
+    static const Level supportedLevel = detectLevel();  // Detect the CPU once
+    Level level = maximumLevel < supportedLevel ? maximumLevel : supportedLevel;
+
+    switch (level)
+    {
+#ifdef POSTFIX_X86_KERNELS
+    case Level::AVX512: return avx512Table;
+    case Level::AVX2: return avx2Table;
+    case Level::SSE2: return sse2Table;
+#endif
+    default: return scalarTable;
+    }
+} // end select
+
+const BatchKernels::KernelTable& BatchKernels::select() noexcept
+{
+    static const KernelTable& bestTable = select(Level::AVX512);
+    return bestTable;
+} // end select
@@ -0,0 +1,107 @@
+/** @file BatchKernels.h
+ * @class BatchKernels
+ * Vectorized kernels for the +,-,*,/ operators of batch evaluation. Kernels are chosen once at runtime from the
+ * instruction sets the CPU supports (AVX-512, AVX2, SSE2), with a portable scalar fallback. Division reports
+ * zero divisors as a lane mask instead of stopping at the first zero. */
+
+#ifndef BATCH_KERNELS_
+#define BATCH_KERNELS_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define POSTFIX_X86_KERNELS 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define POSTFIX_TARGET(features)
+#else
+#define POSTFIX_TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+
+class BatchKernels
+{
+public:
+    /** Instruction set levels a kernel table can be built for, from slowest to fastest. */
+    enum class Level
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    /** Kernel computing result[i] = lhs[i] op rhs[i] for count lanes. */
+    using BinaryKernel = void (*)(const double* lhs, const double* rhs, double* result, std::size_t count);
+
+    /** Kernel computing result[i] = lhs[i] / rhs[i] for count lanes. Sets bit i of zeroMask for every lane whose
+     * divisor is zero. zeroMask must hold (count + 63) / 64 words and is not cleared by the kernel. */
+    using DivideKernel = void (*)(const double* lhs, const double* rhs, double* result, std::size_t count,
+        std::uint64_t zeroMask[]);
+
+    /** The set of kernels for one instruction set level. */
+    struct KernelTable
+    {
+        /** The instruction set level the kernels use. */
+        Level level;
+
+        /** Name of the instruction set level, for logging. */
+        const char* name;
+
+        BinaryKernel add;
+        BinaryKernel subtract;
+        BinaryKernel multiply;
+        DivideKernel divide;
+    };
+
+    /** Gets the fastest kernel table supported by this CPU. Detection runs once.
+     * @pre None
+     * @post None
+     * @return The kernel table to use for batch evaluation. */
+    static const KernelTable& select() noexcept;
+
+    /** Gets the kernel table for a requested level, or the fastest supported level below it.
+     * @pre None
+     * @post None
+     * @param maximumLevel The highest instruction set level to use.
+     * @return The kernel table for the chosen level. */
+    static const KernelTable& select(Level maximumLevel) noexcept;
+
+    /** Gets the highest instruction set level this CPU and operating system support.
+     * @pre None
+     * @post None
+     * @return The detected instruction set level. */
+    static Level detectLevel() noexcept;
+
+private:
+    static void addScalar(const double* lhs, const double* rhs, double* result, std::size_t count);
+    static void subtractScalar(const double* lhs, const double* rhs, double* result, std::size_t count);
+    static void multiplyScalar(const double* lhs, const double* rhs, double* result, std::size_t count);
+    static void divideScalar(const double* lhs, const double* rhs, double* result, std::size_t count,
+        std::uint64_t zeroMask[]);
+
+#ifdef POSTFIX_X86_KERNELS
+    POSTFIX_TARGET("sse2") static void addSSE2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("sse2") static void subtractSSE2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("sse2") static void multiplySSE2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("sse2") static void divideSSE2(const double* lhs, const double* rhs, double* result, std::size_t count,
+        std::uint64_t zeroMask[]);
+
+    POSTFIX_TARGET("avx2") static void addAVX2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx2") static void subtractAVX2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx2") static void multiplyAVX2(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx2") static void divideAVX2(const double* lhs, const double* rhs, double* result, std::size_t count,
+        std::uint64_t zeroMask[]);
+
+    POSTFIX_TARGET("avx512f") static void addAVX512(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx512f") static void subtractAVX512(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx512f") static void multiplyAVX512(const double* lhs, const double* rhs, double* result, std::size_t count);
+    POSTFIX_TARGET("avx512f") static void divideAVX512(const double* lhs, const double* rhs, double* result, std::size_t count,
+        std::uint64_t zeroMask[]);
+#endif
+}; // end BatchKernels
+
+#include "BatchKernels.cpp"
+#endif
@@ -0,0 +1,463 @@
+/** @file Benchmark.cpp
+ * Measures the containers, conversion, evaluation, stringification and startup loading of the project and prints the results as CSV,
+ * or as JSON with --json, so runs can be compared between releases and between alternative implementations.
+ * Usage: Benchmark [--json] [--filter text] [--min-time seconds] [--samples count]
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InfixToPostfixEvaluation.h"
+#include "ParallelEvaluator.h"
+#include "PostfixOptimizer.h"
+#include "MappedProgramLibrary.h"
+#include "ExpressionTemplate.h"
+#include "BatchInfixConverter.h"
+#include "LinkedStack.h"
+#include "ArrayStack.h"
+#include "OurQueue.h"
+#include "RingQueue.h"
+#include "LockFreeQueue.h"
+
+using namespace std;
+
+/** Settings taken from the command line. */
+struct BenchmarkOptions
+{
+	bool json = false;           // Print JSON instead of CSV
+	string filter;               // Only run benchmarks whose name contains this text
+	double minimumSeconds = 0.1; // Minimum duration of each sample
+	int samples = 5;             // Number of timed samples per benchmark, the median is reported
+};
+
+/** Timing of one benchmark. */
+struct BenchmarkResult
+{
+	string name;
+	string parameter;
+	size_t operations;              // Operations per sample
+	double nanosecondsPerOperation; // Median over the samples
+	double minimumNanoseconds;      // Fastest sample
+	double maximumNanoseconds;      // Slowest sample
+};
+
+/** Results are added to this value so the compiler cannot remove the measured work. */
+static volatile double benchmarkSink = 0;
+
+/** Runs a benchmark body repeatedly and records its median time per operation.
+ * @param options The command line settings.
+ * @param results The list the result is added to.
+ * @param name The name of the benchmark.
+ * @param parameter The size or shape the benchmark was run with.
+ * @param operationsPerCall The number of operations one call of body performs.
+ * @param body The work to measure. */
+template<class Body>
+void runBenchmark(const BenchmarkOptions& options, vector<BenchmarkResult>& results, const string& name,
+	const string& parameter, size_t operationsPerCall, Body body)
+{
+	if (!options.filter.empty() && name.find(options.filter) == string::npos)
+	{
+		return;
+	}
+
+	using Clock = chrono::steady_clock;
+
+	// Find how many calls fill the minimum sample time, which also warms up caches and the branch predictor
+	size_t calls = 1;
+	while (true)
+	{
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < calls; ++i) body();
+		double seconds = chrono::duration<double>(Clock::now() - start).count();
+		if (seconds >= options.minimumSeconds || calls >= (size_t(1) << 30)) break;
+		calls *= 2;
+	}
+
+	vector<double> sampleNanoseconds;
+	for (int sample = 0; sample < options.samples; ++sample)
+	{
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < calls; ++i) body();
+		double nanoseconds = chrono::duration<double, nano>(Clock::now() - start).count();
+		sampleNanoseconds.push_back(nanoseconds / double(calls * operationsPerCall));
+	}
+	sort(sampleNanoseconds.begin(), sampleNanoseconds.end());
+
+	results.push_back({ name, parameter, calls * operationsPerCall, sampleNanoseconds[sampleNanoseconds.size() / 2],
+		sampleNanoseconds.front(), sampleNanoseconds.back() });
+}
+
+/** Builds a flat infix expression with a given number of variables, mixing every operator.
+ * @param terms The number of variables in the expression.
+ * @return The expression, for example "a+b*c-d/e". */
+string makeFlatExpression(size_t terms)
+{
+	static const char operators[] = { '+', '*', '-', '/' };
+	string expression;
+	for (size_t i = 0; i < terms; ++i)
+	{
+		if (i > 0) expression += operators[(i - 1) % 4];
+		expression += char('a' + i % 6);
+	}
+	return expression;
+}
+
+/** Builds an infix expression whose parentheses are nested to a given depth.
+ * @param depth The number of nested parentheses.
+ * @return The expression, for example "a*(b+(c-(d+e)))". */
+string makeNestedExpression(size_t depth)
+{
+	static const char operators[] = { '*', '+', '-' };
+	string expression;
+	for (size_t i = 0; i < depth; ++i)
+	{
+		expression += char('a' + i % 6);
+		expression += operators[i % 3];
+		expression += '(';
+	}
+	expression += "a+b";
+	expression.append(depth, ')');
+	return expression;
+}
+
+/** Passes items from producer threads to consumer threads through a shared queue and waits for all of them.
+ * @param producers The number of producer threads.
+ * @param consumers The number of consumer threads.
+ * @param items The number of items, divided evenly between the producers.
+ * @param tryEnqueue Adds one item to the queue, returning false if it could not.
+ * @param tryDequeue Removes one item from the queue into its argument, returning false if there was none. */
+template<class Enqueue, class Dequeue>
+void transferItems(size_t producers, size_t consumers, size_t items, Enqueue tryEnqueue, Dequeue tryDequeue)
+{
+	atomic<size_t> consumed(0);
+	vector<thread> threads;
+	for (size_t p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&]()
+		{
+			for (size_t i = 0; i < items / producers; ++i)
+			{
+				while (!tryEnqueue(int(i))) this_thread::yield();
+			}
+		});
+	}
+	for (size_t c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back([&]()
+		{
+			int item = 0;
+			while (consumed.load(memory_order_relaxed) < items)
+			{
+				if (tryDequeue(item)) consumed.fetch_add(1, memory_order_relaxed);
+				else this_thread::yield();
+			}
+		});
+	}
+	for (thread& worker : threads) worker.join();
+}
+
+/** Prints results as CSV with a header row.
+ * @param results The results to print. */
+void printCsv(const vector<BenchmarkResult>& results)
+{
+	cout << "benchmark,parameter,operations,ns_per_op,min_ns_per_op,max_ns_per_op,ops_per_second" << endl;
+	for (const BenchmarkResult& result : results)
+	{
+		cout << result.name << "," << result.parameter << "," << result.operations << "," << result.nanosecondsPerOperation
+			<< "," << result.minimumNanoseconds << "," << result.maximumNanoseconds << ","
+			<< 1e9 / result.nanosecondsPerOperation << endl;
+	}
+}
+
+/** Prints results as a JSON document that also records the batch kernels in use.
+ * @param results The results to print. */
+void printJson(const vector<BenchmarkResult>& results)
+{
+	cout << "{\"kernels\":\"" << BatchKernels::select().name << "\",\"benchmarks\":[";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const BenchmarkResult& result = results[i];
+		cout << (i > 0 ? "," : "") << endl << "  {\"name\":\"" << result.name << "\",\"parameter\":\"" << result.parameter
+			<< "\",\"operations\":" << result.operations << ",\"ns_per_op\":" << result.nanosecondsPerOperation
+			<< ",\"min_ns_per_op\":" << result.minimumNanoseconds << ",\"max_ns_per_op\":" << result.maximumNanoseconds
+			<< ",\"ops_per_second\":" << 1e9 / result.nanosecondsPerOperation << "}";
+	}
+	cout << endl << "]}" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; ++i)
+	{
+		string argument = argv[i];
+		if (argument == "--json") options.json = true;
+		else if (argument == "--filter" && i + 1 < argc) options.filter = argv[++i];
+		else if (argument == "--min-time" && i + 1 < argc) options.minimumSeconds = atof(argv[++i]);
+		else if (argument == "--samples" && i + 1 < argc) options.samples = max(1, atoi(argv[++i]));
+		else
+		{
+			cerr << "Usage: Benchmark [--json] [--filter text] [--min-time seconds] [--samples count]" << endl;
+			return 1;
+		}
+	}
+
+	vector<BenchmarkResult> results;
+	const size_t containerItems = 1024;
+	const string containerParameter = "items=" + to_string(containerItems);
+
+	// Containers: push or enqueue every item, then pop or dequeue every item. One operation is one push and one pop.
+	runBenchmark(options, results, "stack/LinkedStack/push_pop", containerParameter, containerItems, [&]()
+	{
+		LinkedStack<double> stack;
+		for (size_t i = 0; i < containerItems; ++i) stack.push(double(i));
+		while (!stack.isEmpty()) { benchmarkSink = benchmarkSink + stack.peek(); stack.pop(); }
+	});
+	runBenchmark(options, results, "stack/PmrLinkedStack/push_pop", containerParameter, containerItems, [&]()
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		PmrLinkedStack<double> stack{ std::pmr::polymorphic_allocator<double>(&arena) };
+		for (size_t i = 0; i < containerItems; ++i) stack.push(double(i));
+		while (!stack.isEmpty()) { benchmarkSink = benchmarkSink + stack.peek(); stack.pop(); }
+	});
+	runBenchmark(options, results, "stack/ArrayStack/push_pop", containerParameter, containerItems, [&]()
+	{
+		ArrayStack<double> stack;
+		for (size_t i = 0; i < containerItems; ++i) stack.push(double(i));
+		while (!stack.isEmpty()) { benchmarkSink = benchmarkSink + stack.peek(); stack.pop(); }
+	});
+	runBenchmark(options, results, "queue/OurQueue/enqueue_dequeue", containerParameter, containerItems, [&]()
+	{
+		OurQueue<char> queue;
+		for (size_t i = 0; i < containerItems; ++i) queue.enqueue(char('a' + i % 26));
+		while (!queue.isEmpty()) { benchmarkSink = benchmarkSink + queue.peekFront(); queue.dequeue(); }
+	});
+	runBenchmark(options, results, "queue/RingQueue/enqueue_dequeue", containerParameter, containerItems, [&]()
+	{
+		RingQueue<char> queue;
+		for (size_t i = 0; i < containerItems; ++i) queue.enqueue(char('a' + i % 26));
+		while (!queue.isEmpty()) { benchmarkSink = benchmarkSink + queue.peekFront(); queue.dequeue(); }
+	});
+
+	// Handing items between threads: a mutex-guarded OurQueue against the lock-free queue. One operation is one item.
+	const size_t transferItemCount = size_t(1) << 16;
+	for (size_t threadsPerSide : { size_t(1), size_t(2), size_t(4) })
+	{
+		const string transferParameter = "producers=" + to_string(threadsPerSide) + ";consumers=" +
+			to_string(threadsPerSide) + ";items=" + to_string(transferItemCount);
+		runBenchmark(options, results, "queue/MutexOurQueue/transfer", transferParameter, transferItemCount, [&]()
+		{
+			OurQueue<int> queue;
+			mutex queueMutex;
+			transferItems(threadsPerSide, threadsPerSide, transferItemCount,
+				[&](int item) { lock_guard<mutex> lock(queueMutex); return queue.enqueue(item); },
+				[&](int& item)
+				{
+					lock_guard<mutex> lock(queueMutex);
+					if (queue.isEmpty()) return false;
+					item = queue.peekFront();
+					return queue.dequeue();
+				});
+		});
+		runBenchmark(options, results, "queue/LockFreeQueue/transfer", transferParameter, transferItemCount, [&]()
+		{
+			LockFreeQueue<int> queue;
+			transferItems(threadsPerSide, threadsPerSide, transferItemCount,
+				[&](int item) { return queue.enqueue(item); },
+				[&](int& item) { return queue.tryDequeue(item); });
+		});
+	}
+
+	// Conversion, evaluation and stringification, one operation per call
+	InfixToPostfixEvaluation evaluator;
+	evaluator.readValuesFromFile("variables.txt");
+	InfixToPostfixEvaluation unoptimizedEvaluator;
+	unoptimizedEvaluator.setOptimizationEnabled(false);
+	unoptimizedEvaluator.readValuesFromFile("variables.txt");
+
+	for (size_t terms : { size_t(8), size_t(64), size_t(512) })
+	{
+		const string expression = makeFlatExpression(terms);
+		const string parameter = "terms=" + to_string(terms);
+
+		runBenchmark(options, results, "convert/flat", parameter, 1, [&]()
+		{
+			unoptimizedEvaluator.convertInfixToPostfix(expression);
+		});
+		runBenchmark(options, results, "convert/flat_optimized", parameter, 1, [&]()
+		{
+			evaluator.convertInfixToPostfix(expression);
+		});
+
+		unoptimizedEvaluator.convertInfixToPostfix(expression);
+		runBenchmark(options, results, "evaluate/single", parameter, 1, [&]()
+		{
+			benchmarkSink = benchmarkSink + unoptimizedEvaluator.evaluatePostfixExpression();
+		});
+		runBenchmark(options, results, "stringify/getPostfixExpression", parameter, 1, [&]()
+		{
+			benchmarkSink = benchmarkSink + double(unoptimizedEvaluator.getPostfixExpression().size());
+		});
+	}
+
+	for (size_t depth : { size_t(4), size_t(16), size_t(64) })
+	{
+		const string expression = makeNestedExpression(depth);
+		const string parameter = "depth=" + to_string(depth);
+
+		runBenchmark(options, results, "convert/nested", parameter, 1, [&]()
+		{
+			unoptimizedEvaluator.convertInfixToPostfix(expression);
+		});
+		unoptimizedEvaluator.convertInfixToPostfix(expression);
+		runBenchmark(options, results, "evaluate/nested", parameter, 1, [&]()
+		{
+			benchmarkSink = benchmarkSink + unoptimizedEvaluator.evaluatePostfixExpression();
+		});
+	}
+
+	// A file of formulas converted in one call against one line at a time, one operation per line
+	const size_t batchLineCount = 4096;
+	string batchLines;
+	std::vector<string> batchLineList;
+	for (size_t line = 0; line < batchLineCount; ++line)
+	{
+		batchLineList.push_back(makeFlatExpression(8 + line % 16));
+		batchLines += batchLineList.back();
+		batchLines += '\n';
+	}
+	const string batchConvertParameter = "lines=" + to_string(batchLineCount);
+	runBenchmark(options, results, "convert/lines", batchConvertParameter, batchLineCount, [&]()
+	{
+		for (const string& line : batchLineList)
+		{
+			unoptimizedEvaluator.convertInfixToPostfix(line);
+		}
+	});
+	BatchInfixConverter batchConverter;
+	runBenchmark(options, results, "convert/batch", batchConvertParameter, batchLineCount, [&]()
+	{
+		benchmarkSink = benchmarkSink + double(batchConverter.convert(batchLines));
+	});
+
+	// Repeated subexpressions, with and without the optimizer
+	const string repeatedExpression = "(a+b)*(a+b)-(c*d)/(c*d)+(a+b)*(c*d)";
+	unoptimizedEvaluator.convertInfixToPostfix(repeatedExpression);
+	evaluator.convertInfixToPostfix(repeatedExpression);
+	runBenchmark(options, results, "evaluate/repeated", "optimized=0", 1, [&]()
+	{
+		benchmarkSink = benchmarkSink + unoptimizedEvaluator.evaluatePostfixExpression();
+	});
+	runBenchmark(options, results, "evaluate/repeated", "optimized=1", 1, [&]()
+	{
+		benchmarkSink = benchmarkSink + evaluator.evaluatePostfixExpression();
+	});
+
+	// Evaluation in a caller-owned context that reuses its storage, as each thread sharing a program would
+	EvaluationContext benchmarkContext = evaluator.createEvaluationContext();
+	for (uint32_t slot = 0; slot < SymbolTable::PREDEFINED_COUNT; ++slot) benchmarkContext.setVariable(slot, double(slot + 1));
+	std::shared_ptr<const PostfixProgram> repeatedProgram = evaluator.getCompiledProgram();
+	runBenchmark(options, results, "evaluate/context", "optimized=1", 1, [&]()
+	{
+		benchmarkSink = benchmarkSink + benchmarkContext.evaluate(*repeatedProgram);
+	});
+
+	// Stack interpreter against the register backend on the same unoptimized programs
+	InfixToPostfixEvaluation registerEvaluator;
+	registerEvaluator.setOptimizationEnabled(false);
+	registerEvaluator.setBackend(InfixToPostfixEvaluation::Backend::Register);
+	registerEvaluator.readValuesFromFile("variables.txt");
+	for (const string& shape : { string("terms=64"), string("depth=64") })
+	{
+		const string expression = shape == "terms=64" ? makeFlatExpression(64) : makeNestedExpression(64);
+		unoptimizedEvaluator.convertInfixToPostfix(expression);
+		registerEvaluator.convertInfixToPostfix(expression);
+		runBenchmark(options, results, "evaluate/backend", "backend=stack;" + shape, 1, [&]()
+		{
+			benchmarkSink = benchmarkSink + unoptimizedEvaluator.evaluatePostfixExpression();
+		});
+		runBenchmark(options, results, "evaluate/backend", "backend=register;" + shape, 1, [&]()
+		{
+			benchmarkSink = benchmarkSink + registerEvaluator.evaluatePostfixExpression();
+		});
+	}
+
+	// A formula written as an expression template against the same formula interpreted after conversion.
+	// The template changes a value on every call so the compiler cannot hoist the arithmetic out of the loop.
+	const auto templateFormula = var<'a'>() * (var<'b'>() + var<'c'>()) * (var<'d'>() - var<'e'>()) + var<'f'>();
+	double templateValues[] = { 1, 2, 3, 4, 5, 6 };
+	unoptimizedEvaluator.convertInfixToPostfix("a*(b+c)*(d-e)+f");
+	runBenchmark(options, results, "evaluate/formula", "source=converted", 1, [&]()
+	{
+		benchmarkSink = benchmarkSink + unoptimizedEvaluator.evaluatePostfixExpression();
+	});
+	runBenchmark(options, results, "evaluate/formula", "source=template", 1, [&]()
+	{
+		templateValues[0] += 1;
+		benchmarkSink = benchmarkSink + templateFormula.evaluate(templateValues);
+	});
+
+	// Batch and parallel evaluation, one operation per row
+	const size_t batchRows = size_t(1) << 16;
+	VariableColumns columns;
+	columns.reserve(batchRows);
+	for (size_t row = 0; row < batchRows; ++row)
+	{
+		int rowValues[] = { int(row % 97) + 1, 2, 3, 4, 5, 6 };
+		columns.addRow(rowValues);
+	}
+	unoptimizedEvaluator.convertInfixToPostfix(makeFlatExpression(64));
+	std::shared_ptr<const PostfixProgram> batchProgram = unoptimizedEvaluator.getCompiledProgram();
+	std::vector<double> batchResults(batchRows);
+	const string batchParameter = "terms=64;rows=" + to_string(batchRows);
+
+	runBenchmark(options, results, "evaluate/batch", batchParameter, batchRows, [&]()
+	{
+		batchProgram->evaluateBatch(columns, batchResults.data());
+		benchmarkSink = benchmarkSink + batchResults[0];
+	});
+	ParallelEvaluator parallelEvaluator;
+	runBenchmark(options, results, "evaluate/parallel", batchParameter, batchRows, [&]()
+	{
+		parallelEvaluator.evaluateBatch(*batchProgram, columns, batchResults.data());
+		benchmarkSink = benchmarkSink + batchResults[0];
+	});
+
+	// Startup: converting every formula again against mapping a library written once, one operation per formula
+	const size_t libraryFormulas = 1024;
+	const string libraryExpression = makeFlatExpression(16);
+	std::vector<std::shared_ptr<const PostfixProgram>> libraryPrograms;
+	for (size_t i = 0; i < libraryFormulas; ++i)
+	{
+		evaluator.convertInfixToPostfix(libraryExpression);
+		libraryPrograms.push_back(evaluator.getCompiledProgram());
+	}
+	MappedProgramLibrary::write("benchmarkPrograms.pfxl", libraryPrograms);
+	const string libraryParameter = "terms=16;formulas=" + to_string(libraryFormulas);
+
+	runBenchmark(options, results, "startup/convert", libraryParameter, libraryFormulas, [&]()
+	{
+		for (size_t i = 0; i < libraryFormulas; ++i) unoptimizedEvaluator.convertInfixToPostfix(libraryExpression);
+	});
+	runBenchmark(options, results, "startup/library", libraryParameter, libraryFormulas, [&]()
+	{
+		MappedProgramLibrary library("benchmarkPrograms.pfxl");
+		benchmarkSink = benchmarkSink + double(library.size());
+	});
+	std::remove("benchmarkPrograms.pfxl");
+
+	if (options.json) printJson(results);
+	else printCsv(results);
+	return 0;
+}
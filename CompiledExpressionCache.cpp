@@ -0,0 +1,100 @@
+/** @file CompiledExpressionCache.cpp
+ * CompiledExpressionCache keeps the most recently used compiled programs keyed by normalized infix text.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "CompiledExpressionCache.h"
+
+CompiledExpressionCache::CompiledExpressionCache(std::size_t maximumEntries)
+    : capacity(maximumEntries), hitCount(0), missCount(0), evictionCount(0)
+{ } // end constructor
+
+std::string CompiledExpressionCache::normalize(const std::string& infixExpression)
+{
+    std::string key;
+    key.reserve(infixExpression.size());
+
+    ExpressionTokenizer tokenizer(infixExpression);
+    ExpressionTokenizer::Token token;
+    bool previousOperand = false;
+
+    while (tokenizer.next(token))
+    {
+        if (token.kind == ExpressionTokenizer::TokenKind::Invalid) continue;  // Ignored by the converter too
+
+        bool operand = ExpressionTokenizer::isOperand(token);
+        if (operand && previousOperand) key += ' ';  // Keep the boundary between adjacent operands
+        for (char tokenChar : token.text)
+        {
+            key += static_cast<char>(std::tolower(static_cast<unsigned char>(tokenChar)));  // Same lowercasing as convertInfixToPostfix
+        }
+        previousOperand = operand;
+    }
+    return key;
+} // end normalize
+
+std::shared_ptr<const PostfixProgram> CompiledExpressionCache::find(const std::string& key, const SymbolTable* symbols)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto found = entryIndex.find(key);
+    if (found == entryIndex.end() || (symbols != nullptr && found->second->second->getSymbolTable() != nullptr &&
+        found->second->second->getSymbolTable().get() != symbols))  // Compiled with another table
+    {
+        ++missCount;
+        return nullptr;
+    }
+
+    ++hitCount;
+    recencyList.splice(recencyList.begin(), recencyList, found->second);  // Mark as most recently used
+    return found->second->second;
+} // end find
+
+void CompiledExpressionCache::insert(const std::string& key, std::shared_ptr<const PostfixProgram> program)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (capacity == 0) return;
+
+    auto found = entryIndex.find(key);
+    if (found != entryIndex.end())  // Another thread compiled the same text first
+    {
+        found->second->second = std::move(program);
+        recencyList.splice(recencyList.begin(), recencyList, found->second);
+        return;
+    }
+
+    recencyList.emplace_front(key, std::move(program));
+    entryIndex.emplace(key, recencyList.begin());
+    evictToCapacity();
+} // end insert
+
+void CompiledExpressionCache::setCapacity(std::size_t maximumEntries)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    capacity = maximumEntries;
+    evictToCapacity();
+} // end setCapacity
+
+void CompiledExpressionCache::clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    recencyList.clear();
+    entryIndex.clear();
+} // end clear
+
+CompiledExpressionCache::Statistics CompiledExpressionCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return { hitCount, missCount, evictionCount, recencyList.size(), capacity };
+} // end getStatistics
+
+void CompiledExpressionCache::evictToCapacity()
+{
+    while (recencyList.size() > capacity)
+    {
+        entryIndex.erase(recencyList.back().first);  // Least recently used entry is at the back
+        recencyList.pop_back();
+        ++evictionCount;
+    }
+} // end evictToCapacity
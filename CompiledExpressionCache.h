@@ -0,0 +1,113 @@
+/** @file CompiledExpressionCache.h
+ * @class CompiledExpressionCache
+ * Bounded, thread-safe least-recently-used cache from normalized infix text to compiled postfix programs. Programs
+ * are immutable and shared, so a cached program can be handed to many evaluators at once. Hit, miss and eviction
+ * counts are kept for monitoring. */
+
+#ifndef COMPILED_EXPRESSION_CACHE_
+#define COMPILED_EXPRESSION_CACHE_
+
+#include <cstddef>
+#include <cctype>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <utility>
+#include <unordered_map>
+#include "PostfixProgram.h"
+#include "SymbolTable.h"
+#include "ExpressionTokenizer.h"
+
+class CompiledExpressionCache
+{
+public:
+    /** Snapshot of the cache counters. */
+    struct Statistics
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t evictions;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    /** Default number of programs a cache holds. */
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+private:
+    /** A cached program and the key it is stored under. */
+    using Entry = std::pair<std::string, std::shared_ptr<const PostfixProgram>>;
+
+    /** Entries from most to least recently used. */
+    std::list<Entry> recencyList;
+
+    /** Index from key to its entry in recencyList. */
+    std::unordered_map<std::string, std::list<Entry>::iterator> entryIndex;
+
+    /** Maximum number of entries. */
+    std::size_t capacity;
+
+    /** Counters reported by getStatistics. */
+    std::size_t hitCount;
+    std::size_t missCount;
+    std::size_t evictionCount;
+
+    /** Guards every member above. */
+    mutable std::mutex cacheMutex;
+
+    /** Removes least recently used entries until the cache holds at most capacity entries.
+     * @pre cacheMutex is held. */
+    void evictToCapacity();
+
+public:
+    /** Creates an empty cache.
+     * @param maximumEntries The maximum number of programs to keep. 0 disables caching. */
+    explicit CompiledExpressionCache(std::size_t maximumEntries = DEFAULT_CAPACITY);
+
+    /** Normalizes infix text into a cache key. Tokens are lowercased, as convertInfixToPostfix does, and characters
+     * the converter ignores are dropped, so texts that convert to the same program share one key. A single space is
+     * kept between adjacent operands, so "a b" and "ab" have different keys.
+     * @pre None
+     * @post None
+     * @param infixExpression The infix expression.
+     * @return The normalized key. */
+    static std::string normalize(const std::string& infixExpression);
+
+    /** Looks up a program and marks it most recently used. Counts a hit or a miss. A program that uses variables
+     * past a-f only matches if it was compiled with the same symbol table, since its slots come from that table.
+     * @pre key is normalized.
+     * @post None
+     * @param key The normalized infix text.
+     * @param symbols The symbol table of the caller, or nullptr to accept any program.
+     * @return The cached program, or nullptr on a miss. */
+    std::shared_ptr<const PostfixProgram> find(const std::string& key, const SymbolTable* symbols = nullptr);
+
+    /** Adds or replaces a program as the most recently used entry, evicting the least recently used entry if the
+     * cache is full.
+     * @pre key is normalized.
+     * @post The program is cached unless the capacity is 0.
+     * @param key The normalized infix text.
+     * @param program The compiled program for key. */
+    void insert(const std::string& key, std::shared_ptr<const PostfixProgram> program);
+
+    /** Changes the maximum number of entries, evicting entries if the cache is now too full.
+     * @pre None
+     * @post The cache holds at most maximumEntries entries.
+     * @param maximumEntries The new capacity. 0 disables caching. */
+    void setCapacity(std::size_t maximumEntries);
+
+    /** Removes every entry. Counters are kept.
+     * @pre None
+     * @post The cache is empty. */
+    void clear();
+
+    /** Gets a snapshot of the counters.
+     * @pre None
+     * @post None
+     * @return The hits, misses, evictions, size and capacity of the cache. */
+    Statistics getStatistics() const;
+}; // end CompiledExpressionCache
+
+#include "CompiledExpressionCache.cpp"
+#endif
@@ -0,0 +1,176 @@
+/** @file EvaluationContext.cpp
+ * EvaluationContext holds the variable values and working storage one thread needs to evaluate shared programs.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "EvaluationContext.h"
+
+EvaluationContext::EvaluationContext() : EvaluationContext(std::make_shared<SymbolTable>())
+{ } // end default constructor
+
+EvaluationContext::EvaluationContext(std::shared_ptr<SymbolTable> symbols)
+    : symbolTable(std::move(symbols)), variableValues(SymbolTable::PREDEFINED_COUNT, 0),
+    assignedSlots(SymbolTable::PREDEFINED_COUNT, true), unassignedCount(0)
+{ } // end constructor
+
+std::shared_ptr<SymbolTable> EvaluationContext::getSymbolTable() const noexcept
+{
+    return symbolTable;
+} // end getSymbolTable
+
+std::uint32_t EvaluationContext::getSlot(std::string_view name)
+{
+    return symbolTable->intern(name);
+} // end getSlot
+
+void EvaluationContext::setVariable(std::uint32_t slot, double value)
+{
+    if (slot >= variableValues.size())  // Slots skipped over have no value yet
+    {
+        unassignedCount += slot - variableValues.size();
+        variableValues.resize(slot + 1, 0);
+        assignedSlots.resize(slot + 1, false);
+    }
+    else if (!assignedSlots[slot])
+    {
+        --unassignedCount;
+    }
+    variableValues[slot] = value;
+    assignedSlots[slot] = true;
+} // end setVariable
+
+void EvaluationContext::setVariable(std::string_view name, double value)
+{
+    setVariable(getSlot(name), value);
+} // end setVariable
+
+double EvaluationContext::getVariable(std::string_view name) const
+{
+    std::uint32_t slot = symbolTable->find(name);
+    if (!isAssigned(slot))
+    {
+        throw std::runtime_error("Unknown variable: " + std::string(name));
+    }
+    return variableValues[slot];
+} // end getVariable
+
+bool EvaluationContext::isAssigned(std::uint32_t slot) const noexcept
+{
+    return slot < assignedSlots.size() && assignedSlots[slot];
+} // end isAssigned
+
+const double* EvaluationContext::getValues() const noexcept
+{
+    return variableValues.data();
+} // end getValues
+
+std::size_t EvaluationContext::getValueCount() const noexcept
+{
+    return variableValues.size();
+} // end getValueCount
+
+void EvaluationContext::clear() noexcept
+{
+    for (double& value : variableValues)
+    {
+        value = 0;
+    }
+} // end clear
+
+std::string EvaluationContext::getSlotName(std::uint32_t slot) const
+{
+    if (slot < symbolTable->size()) return symbolTable->getName(slot);
+    return "#" + std::to_string(slot);
+} // end getSlotName
+
+bool EvaluationContext::findUnassignedSlot(const PostfixProgramView& program, std::uint32_t& missingSlot) const noexcept
+{
+    // Variables a-f always have values, so most programs skip the scan
+    if (program.getSlotCount() <= variableValues.size() &&
+        (unassignedCount == 0 || program.getSlotCount() <= SymbolTable::PREDEFINED_COUNT))
+    {
+        return true;
+    }
+
+    for (const PostfixProgramView::Instruction& instruction : program)
+    {
+        if (instruction.opcode == PostfixProgramView::OpCode::PushVariable && !isAssigned(instruction.operand))
+        {
+            missingSlot = instruction.operand;
+            return false;
+        }
+    }
+    return true;
+} // end findUnassignedSlot
+
+bool EvaluationContext::findUnassignedSlot(const RegisterProgram& program, std::uint32_t& missingSlot) const noexcept
+{
+    if (program.getSlotCount() <= variableValues.size() &&
+        (unassignedCount == 0 || program.getSlotCount() <= SymbolTable::PREDEFINED_COUNT))
+    {
+        return true;
+    }
+
+    for (const RegisterProgram::VariableLoad& load : program.getVariableLoads())
+    {
+        if (!isAssigned(load.slot))
+        {
+            missingSlot = load.slot;
+            return false;
+        }
+    }
+    return true;
+} // end findUnassignedSlot
+
+// Checks either kind of program, naming the first variable without a value
+template<class ProgramType>
+void EvaluationContext::checkVariablesAssigned(const ProgramType& program) const
+{
+    std::uint32_t missingSlot = 0;
+    if (!findUnassignedSlot(program, missingSlot))
+    {
+        throw std::runtime_error("Unknown variable: " + getSlotName(missingSlot));
+    }
+} // end checkVariablesAssigned
+
+double EvaluationContext::evaluate(const PostfixProgramView& program)
+{
+    checkVariablesAssigned(program);
+    return program.evaluate(variableValues.data(), variableValues.size(), scratch);
+} // end evaluate
+
+double EvaluationContext::evaluate(const PostfixProgram& program)
+{
+    return evaluate(program.getView());
+} // end evaluate
+
+EvaluationResult EvaluationContext::tryEvaluate(const PostfixProgramView& program)
+{
+    std::uint32_t missingSlot = 0;
+    if (!findUnassignedSlot(program, missingSlot)) return { 0, EvaluationStatus::UnknownVariable };
+    return program.tryEvaluate(variableValues.data(), variableValues.size(), scratch);
+} // end tryEvaluate
+
+EvaluationResult EvaluationContext::tryEvaluate(const PostfixProgram& program)
+{
+    return tryEvaluate(program.getView());
+} // end tryEvaluate
+
+double EvaluationContext::evaluate(const RegisterProgram& program)
+{
+    checkVariablesAssigned(program);
+    EvaluationResult result = program.tryEvaluate(variableValues.data(), variableValues.size(), scratch);
+    if (!result.isOk())
+    {
+        throw std::runtime_error(EvaluationResult::describe(result.status));
+    }
+    return result.value;
+} // end evaluate
+
+EvaluationResult EvaluationContext::tryEvaluate(const RegisterProgram& program)
+{
+    std::uint32_t missingSlot = 0;
+    if (!findUnassignedSlot(program, missingSlot)) return { 0, EvaluationStatus::UnknownVariable };
+    return program.tryEvaluate(variableValues.data(), variableValues.size(), scratch);
+} // end tryEvaluate
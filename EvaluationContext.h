@@ -0,0 +1,198 @@
+/** @file EvaluationContext.h
+ * @class EvaluationContext
+ * Per-thread state for evaluating compiled programs: the variable values and the working storage of the
+ * interpreter. Compiled programs are immutable, so one program, or a whole registry of them, can be shared by any
+ * number of threads that each evaluate it in their own context. Nothing on the evaluation path takes a lock. */
+
+#ifndef EVALUATION_CONTEXT_
+#define EVALUATION_CONTEXT_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "PostfixProgram.h"
+#include "PostfixProgramView.h"
+#include "RegisterProgram.h"
+#include "SymbolTable.h"
+
+class EvaluationContext
+{
+private:
+    /** Table that assigns slots to variable names, shared with the converter that compiled the programs. */
+    std::shared_ptr<SymbolTable> symbolTable;
+
+    /** Values of the variables indexed by slot: a-f first, then named variables. Values of a-f are initially 0. */
+    std::vector<double> variableValues;
+
+    /** True for each slot that has a value. Variables a-f always have values. */
+    std::vector<bool> assignedSlots;
+
+    /** Number of slots below variableValues.size() that have no value, so programs only need to be checked for
+     * missing variables while some exist. */
+    std::size_t unassignedCount;
+
+    /** Working storage of the interpreter, reused by every evaluation in this context. */
+    PostfixProgramView::Scratch scratch;
+
+    /** Gets the name of a slot for error messages.
+     * @pre None
+     * @post None
+     * @param slot The slot.
+     * @return The name of the slot in the symbol table, or its number if the table does not name it. */
+    std::string getSlotName(std::uint32_t slot) const;
+
+    /** Finds whether every variable used by a program has a value.
+     * @pre None
+     * @post None
+     * @param program The program to check.
+     * @param missingSlot Receives the first slot used by the program that has no value, if there is one.
+     * @return True if every variable used by the program has a value. */
+    bool findUnassignedSlot(const PostfixProgramView& program, std::uint32_t& missingSlot) const noexcept;
+
+    /** Finds whether every variable used by a register program has a value.
+     * @pre None
+     * @post None
+     * @param program The program to check.
+     * @param missingSlot Receives the first slot used by the program that has no value, if there is one.
+     * @return True if every variable used by the program has a value. */
+    bool findUnassignedSlot(const RegisterProgram& program, std::uint32_t& missingSlot) const noexcept;
+
+    /** Checks that every variable used by a program has a value.
+     * @pre None
+     * @post None
+     * @param program The program to check.
+     * @throws std::runtime_error If a variable used by the program has no value. */
+    template<class ProgramType>
+    void checkVariablesAssigned(const ProgramType& program) const;
+
+public:
+    /** Default constructor. Creates a context with its own symbol table. */
+    EvaluationContext();
+
+    /** Creates a context that names variables with a shared symbol table.
+     * @param symbols The table that compiled the programs to be evaluated. */
+    explicit EvaluationContext(std::shared_ptr<SymbolTable> symbols);
+
+    /** Gets the table that assigns slots to variable names.
+     * @pre None
+     * @post None
+     * @return The symbol table. */
+    std::shared_ptr<SymbolTable> getSymbolTable() const noexcept;
+
+    /** Gets the slot of a variable, adding the name to the symbol table if it is new. Looking a slot up once and
+     * setting values by slot keeps the symbol table lock out of loops.
+     * @pre None
+     * @post The symbol table holds the name.
+     * @param name The variable name.
+     * @return The slot of the variable.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    std::uint32_t getSlot(std::string_view name);
+
+    /** Sets the value of a variable slot.
+     * @pre None
+     * @post The slot has the value.
+     * @param slot The slot, as returned by getSlot().
+     * @param value The new value. */
+    void setVariable(std::uint32_t slot, double value);
+
+    /** Sets the value of a variable, adding the name to the symbol table if it is new.
+     * @pre None
+     * @post The variable has the value.
+     * @param name The variable name.
+     * @param value The new value.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    void setVariable(std::string_view name, double value);
+
+    /** Gets the value of a variable.
+     * @pre None
+     * @post None
+     * @param name The variable name.
+     * @return The value of the variable.
+     * @throws std::runtime_error If the variable has no value. */
+    double getVariable(std::string_view name) const;
+
+    /** Checks whether a slot has a value.
+     * @pre None
+     * @post None
+     * @param slot The slot.
+     * @return True if the slot has a value. */
+    bool isAssigned(std::uint32_t slot) const noexcept;
+
+    /** Gets the values of the variables.
+     * @pre None
+     * @post None
+     * @return A pointer to the values, indexed by slot. */
+    const double* getValues() const noexcept;
+
+    /** Gets the number of slots that have storage for a value, assigned or not.
+     * @pre None
+     * @post None
+     * @return The number of values. */
+    std::size_t getValueCount() const noexcept;
+
+    /** Sets every value to 0, keeping named variables assigned.
+     * @pre None
+     * @post Every value is 0. */
+    void clear() noexcept;
+
+    /** Evaluates a program against the variable values of this context.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If a variable used by the program has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const PostfixProgramView& program);
+
+    /** Evaluates a program against the variable values of this context.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If a variable used by the program has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const PostfixProgram& program);
+
+    /** Evaluates a program against the variable values of this context without throwing.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const PostfixProgramView& program);
+
+    /** Evaluates a program against the variable values of this context without throwing.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const PostfixProgram& program);
+
+    /** Evaluates a program lowered to registers against the variable values of this context.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If a variable used by the program has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const RegisterProgram& program);
+
+    /** Evaluates a program lowered to registers against the variable values of this context without throwing.
+     * @pre The program was compiled with the symbol table of this context, or only uses variables a-f.
+     * @post Does not change the program or the variable values.
+     * @param program The program to evaluate.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const RegisterProgram& program);
+}; // end EvaluationContext
+
+#include "EvaluationContext.cpp"
+#endif
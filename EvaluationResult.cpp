@@ -0,0 +1,30 @@
+/** @file EvaluationResult.cpp
+ * EvaluationResult reports the outcome of an evaluation without throwing.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "EvaluationResult.h"
+
+bool EvaluationResult::isOk() const noexcept
+{
+    return status == EvaluationStatus::Ok;
+} // end isOk
+
+const char* EvaluationResult::describe(EvaluationStatus status) noexcept
+{
+    switch (status)
+    {
+    case EvaluationStatus::Ok: return "Ok";
+    case EvaluationStatus::InvalidExpression: return "Invalid postfix expression";
+    case EvaluationStatus::UnknownOperator: return "Unknown operator encountered";
+    case EvaluationStatus::UnknownVariable: return "Unknown variable";
+    case EvaluationStatus::DivisionByZero: return "Division by zero";
+    }
+    return "Unknown error";
+} // end describe
+
+bool BatchEvaluationResult::hasRowError(std::size_t row) const noexcept
+{
+    return (rowErrors[row / 64] >> (row % 64)) & 1;
+} // end hasRowError
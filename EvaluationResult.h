@@ -0,0 +1,70 @@
+/** @file EvaluationResult.h
+ * @class EvaluationResult
+ * Outcome of an evaluation that reports errors as a status instead of throwing, in the manner of std::expected.
+ * Batch scoring uses BatchEvaluationResult, which marks the rows that divided by zero in a bitmap next to the
+ * results, so a few bad rows cost a bit each instead of an exception each. */
+
+#ifndef EVALUATION_RESULT_
+#define EVALUATION_RESULT_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** Why an evaluation did or did not produce a value. */
+enum class EvaluationStatus : std::uint8_t
+{
+    Ok,                // The value is the result
+    InvalidExpression, // The program is not a well-formed postfix expression
+    UnknownOperator,   // The program holds a character that is not an operator
+    UnknownVariable,   // The program uses a variable that has no value
+    DivisionByZero     // A divisor was zero
+};
+
+struct EvaluationResult
+{
+    /** The result of the evaluation, or 0 if status is not Ok. */
+    double value;
+
+    /** Whether the evaluation succeeded. */
+    EvaluationStatus status;
+
+    /** Checks whether the evaluation succeeded.
+     * @pre None
+     * @post None
+     * @return True if status is Ok. */
+    bool isOk() const noexcept;
+
+    /** Gets the message the throwing evaluation functions use for a status.
+     * @pre None
+     * @post None
+     * @param status The status.
+     * @return The message, such as "Division by zero". */
+    static const char* describe(EvaluationStatus status) noexcept;
+}; // end EvaluationResult
+
+struct BatchEvaluationResult
+{
+    /** Ok if every row was evaluated, even if some divided by zero. Otherwise the error of the whole program, and
+     * values holds no results. */
+    EvaluationStatus status;
+
+    /** One result per row. The values of rows marked in rowErrors are unspecified. */
+    std::vector<double> values;
+
+    /** Bit r % 64 of word r / 64 is set if row r divided by zero. */
+    std::vector<std::uint64_t> rowErrors;
+
+    /** Number of rows that divided by zero. */
+    std::size_t errorCount;
+
+    /** Checks whether a row divided by zero.
+     * @pre row is less than values.size().
+     * @post None
+     * @param row The row.
+     * @return True if the row has no valid result. */
+    bool hasRowError(std::size_t row) const noexcept;
+}; // end BatchEvaluationResult
+
+#include "EvaluationResult.cpp"
+#endif
@@ -0,0 +1,184 @@
+/** @file ExpressionDag.cpp
+ * ExpressionDag stores each distinct subexpression once and simplifies operations as they are added.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ExpressionDag.h"
+
+bool ExpressionDag::NodeKey::operator==(const NodeKey& other) const noexcept
+{
+    return kind == other.kind && slot == other.slot && valueBits == other.valueBits &&
+        left == other.left && right == other.right;
+} // end operator==
+
+std::size_t ExpressionDag::NodeKeyHash::operator()(const NodeKey& key) const noexcept
+{
+    std::size_t hash = std::hash<std::uint64_t>()(key.valueBits);
+    hash = hash * 31 + static_cast<std::size_t>(key.kind);
+    hash = hash * 31 + key.slot;
+    hash = hash * 31 + key.left;
+    hash = hash * 31 + key.right;
+    return hash;
+} // end operator()
+
+ExpressionDag::ExpressionDag()
+{ } // end default constructor
+
+ExpressionDag::ExpressionDag(Options dagOptions) : options(dagOptions)
+{ } // end constructor
+
+std::size_t ExpressionDag::size() const noexcept
+{
+    return nodes.size();
+} // end size
+
+const ExpressionDag::Node& ExpressionDag::getNode(std::size_t id) const noexcept
+{
+    return nodes[id];
+} // end getNode
+
+std::size_t ExpressionDag::intern(const Node& node)
+{
+    NodeKey key = { node.kind, node.slot, 0, node.left, node.right };
+    std::memcpy(&key.valueBits, &node.value, sizeof(key.valueBits));
+
+    auto found = nodeIndex.find(key);
+    if (found != nodeIndex.end())  // Same subexpression seen before
+    {
+        return found->second;
+    }
+
+    nodes.push_back(node);
+    nodeIndex.emplace(key, nodes.size() - 1);
+    return nodes.size() - 1;
+} // end intern
+
+bool ExpressionDag::isConstant(std::size_t id, double value) const noexcept
+{
+    return nodes[id].kind == NodeKind::Constant && nodes[id].value == value;
+} // end isConstant
+
+std::size_t ExpressionDag::addVariable(std::uint32_t slot)
+{
+    return intern({ NodeKind::Variable, slot, 0, NO_NODE, NO_NODE, false });
+} // end addVariable
+
+std::size_t ExpressionDag::addConstant(double value)
+{
+    return intern({ NodeKind::Constant, 0, value, NO_NODE, NO_NODE, false });
+} // end addConstant
+
+std::size_t ExpressionDag::addOperation(NodeKind kind, std::size_t left, std::size_t right)
+{
+    const Node& leftNode = nodes[left];
+    const Node& rightNode = nodes[right];
+
+    // Fold operations on two constants, except division by zero, which must still fail when evaluated
+    if (leftNode.kind == NodeKind::Constant && rightNode.kind == NodeKind::Constant)
+    {
+        switch (kind)
+        {
+        case NodeKind::Add: return addConstant(leftNode.value + rightNode.value);
+        case NodeKind::Subtract: return addConstant(leftNode.value - rightNode.value);
+        case NodeKind::Multiply: return addConstant(leftNode.value * rightNode.value);
+        case NodeKind::Divide:
+            if (rightNode.value != 0) return addConstant(leftNode.value / rightNode.value);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Identities that hold for every value, including infinities, NaN and negative zero
+    switch (kind)
+    {
+    case NodeKind::Multiply:
+        if (isConstant(right, 1)) return left;
+        if (isConstant(left, 1)) return right;
+        break;
+    case NodeKind::Divide:
+        if (isConstant(right, 1)) return left;
+        break;
+    case NodeKind::Subtract:
+        if (isConstant(right, 0) && !std::signbit(rightNode.value)) return left;  // x - (-0) is not x when x is -0
+        break;
+    default:
+        break;
+    }
+
+    // Identities that only hold for finite values, and only when no division is dropped with the removed operand
+    if (options.assumeFinite)
+    {
+        if (kind == NodeKind::Subtract && left == right && !leftNode.containsDivision)
+        {
+            return addConstant(0);
+        }
+        if (kind == NodeKind::Multiply && ((isConstant(right, 0) && !leftNode.containsDivision) ||
+            (isConstant(left, 0) && !rightNode.containsDivision)))
+        {
+            return addConstant(0);
+        }
+    }
+
+    // Put operands of commutative operations in a fixed order so a+b and b+a share a node
+    if ((kind == NodeKind::Add || kind == NodeKind::Multiply) && right < left)
+    {
+        std::swap(left, right);
+    }
+
+    bool containsDivision = kind == NodeKind::Divide || nodes[left].containsDivision || nodes[right].containsDivision;
+    return intern({ kind, 0, 0, left, right, containsDivision });
+} // end addOperation
+
+std::size_t ExpressionDag::addProgram(const PostfixProgram& program)
+{
+    std::vector<std::size_t> operandIds;     // Stack of node ids, mirroring the evaluation stack
+    std::vector<std::size_t> temporaryIds(program.getTemporaryCount(), NO_NODE);
+
+    for (const PostfixProgram::Instruction& instruction : program)
+    {
+        switch (instruction.opcode)
+        {
+        case PostfixProgram::OpCode::PushVariable:
+            operandIds.push_back(addVariable(instruction.operand));
+            continue;
+        case PostfixProgram::OpCode::PushConstant:
+            operandIds.push_back(addConstant(program.getConstants()[instruction.operand]));
+            continue;
+        case PostfixProgram::OpCode::LoadTemporary:
+            if (temporaryIds[instruction.operand] == NO_NODE) throw std::runtime_error("Invalid postfix expression");
+            operandIds.push_back(temporaryIds[instruction.operand]);
+            continue;
+        case PostfixProgram::OpCode::StoreTemporary:
+            if (operandIds.empty()) throw std::runtime_error("Invalid postfix expression");
+            temporaryIds[instruction.operand] = operandIds.back();
+            continue;
+        default:
+            break;
+        }
+
+        // Operator, checked in the same order as PostfixProgram::evaluate
+        if (operandIds.size() < 2) throw std::runtime_error("Invalid postfix expression");
+
+        NodeKind kind;
+        switch (instruction.opcode)
+        {
+        case PostfixProgram::OpCode::Add: kind = NodeKind::Add; break;
+        case PostfixProgram::OpCode::Subtract: kind = NodeKind::Subtract; break;
+        case PostfixProgram::OpCode::Multiply: kind = NodeKind::Multiply; break;
+        case PostfixProgram::OpCode::Divide: kind = NodeKind::Divide; break;
+        default:
+            throw std::runtime_error("Unknown operator encountered");
+        }
+
+        std::size_t right = operandIds.back();
+        operandIds.pop_back();
+        std::size_t left = operandIds.back();
+        operandIds.back() = addOperation(kind, left, right);
+    }
+
+    // The final result should be the only value left
+    if (operandIds.size() != 1) throw std::runtime_error("Invalid postfix expression");
+    return operandIds.back();
+} // end addProgram
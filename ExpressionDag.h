@@ -0,0 +1,169 @@
+/** @file ExpressionDag.h
+ * @class ExpressionDag
+ * Directed acyclic graph of expression nodes built from compiled postfix programs. Identical subexpressions are
+ * stored once (hash-consing), so a subterm repeated in an expression, or shared between expressions, becomes a
+ * single node. Constant operations are folded and identities that are exact under IEEE arithmetic are simplified
+ * as nodes are added. Nodes are only ever appended after their operands, so node ids are in topological order. */
+
+#ifndef EXPRESSION_DAG_
+#define EXPRESSION_DAG_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "PostfixProgram.h"
+
+class ExpressionDag
+{
+public:
+    /** Kinds of nodes in the graph. */
+    enum class NodeKind : std::uint8_t
+    {
+        Variable,  // Value of a variable slot
+        Constant,  // Fixed value
+        Add,
+        Subtract,
+        Multiply,
+        Divide
+    };
+
+    /** A single node of the graph. */
+    struct Node
+    {
+        /** The kind of node. */
+        NodeKind kind;
+
+        /** Variable slot of a Variable node, otherwise 0. */
+        std::uint32_t slot;
+
+        /** Value of a Constant node, otherwise 0. */
+        double value;
+
+        /** Id of the left operand of an operation node, otherwise NO_NODE. */
+        std::size_t left;
+
+        /** Id of the right operand of an operation node, otherwise NO_NODE. */
+        std::size_t right;
+
+        /** True if the node or any node below it is a division, which can fail at evaluation time. */
+        bool containsDivision;
+    };
+
+    /** Rules the graph may use beyond the ones that are exact for every IEEE value. */
+    struct Options
+    {
+        /** Assume every variable is finite and ignore the sign of zero, which allows x-x and x*0 to become 0.
+         * Subexpressions that contain a division are never removed, so division by zero is still reported. */
+        bool assumeFinite = false;
+    };
+
+    /** Id used for missing operands. */
+    static constexpr std::size_t NO_NODE = std::numeric_limits<std::size_t>::max();
+
+private:
+    /** Fields that identify a node for hash-consing. Constants are compared by bit pattern so 0 and -0 differ. */
+    struct NodeKey
+    {
+        NodeKind kind;
+        std::uint32_t slot;
+        std::uint64_t valueBits;
+        std::size_t left;
+        std::size_t right;
+
+        bool operator==(const NodeKey& other) const noexcept;
+    };
+
+    /** Hash of a NodeKey. */
+    struct NodeKeyHash
+    {
+        std::size_t operator()(const NodeKey& key) const noexcept;
+    };
+
+    /** Simplification rules in effect. */
+    Options options;
+
+    /** Nodes in the order they were added. */
+    std::vector<Node> nodes;
+
+    /** Index from node fields to the id of the node that has them. */
+    std::unordered_map<NodeKey, std::size_t, NodeKeyHash> nodeIndex;
+
+    /** Adds a node unless an identical node already exists.
+     * @pre Operands of an operation node are valid ids.
+     * @post The graph holds the node.
+     * @param node The node to add.
+     * @return The id of the new or existing node. */
+    std::size_t intern(const Node& node);
+
+    /** Checks whether a node is a constant with a given value.
+     * @pre id is a valid node id.
+     * @post None
+     * @param id The node to check.
+     * @param value The value to compare with.
+     * @return True if the node is a Constant equal to value. */
+    bool isConstant(std::size_t id, double value) const noexcept;
+
+public:
+    /** Default constructor. Creates an empty graph that only applies exact rules. */
+    ExpressionDag();
+
+    /** Creates an empty graph.
+     * @pre None
+     * @post The graph is empty.
+     * @param dagOptions The simplification rules the graph may use. */
+    explicit ExpressionDag(Options dagOptions);
+
+    /** Gets the number of nodes in the graph.
+     * @pre None
+     * @post None
+     * @return The number of nodes. */
+    std::size_t size() const noexcept;
+
+    /** Gets a node of the graph.
+     * @pre id is less than size().
+     * @post None
+     * @param id The id of the node.
+     * @return The node. */
+    const Node& getNode(std::size_t id) const noexcept;
+
+    /** Adds a node for a variable.
+     * @pre None
+     * @post The graph holds a node for the variable.
+     * @param slot The variable slot.
+     * @return The id of the node. */
+    std::size_t addVariable(std::uint32_t slot);
+
+    /** Adds a node for a constant.
+     * @pre None
+     * @post The graph holds a node for the constant.
+     * @param value The constant value.
+     * @return The id of the node. */
+    std::size_t addConstant(double value);
+
+    /** Adds a node for an operation, folding constants and simplifying identities first.
+     * @pre left and right are valid node ids and kind is an operation.
+     * @post The graph holds a node equal to the operation.
+     * @param kind The operation.
+     * @param left The id of the left operand.
+     * @param right The id of the right operand.
+     * @return The id of the node that computes the operation, which may be an existing node. */
+    std::size_t addOperation(NodeKind kind, std::size_t left, std::size_t right);
+
+    /** Adds the nodes of a compiled program to the graph.
+     * @pre None
+     * @post The graph holds a node for every subexpression of the program.
+     * @param program The program to add.
+     * @return The id of the node that computes the result of the program.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered. */
+    std::size_t addProgram(const PostfixProgram& program);
+}; // end ExpressionDag
+
+#include "ExpressionDag.cpp"
+#endif
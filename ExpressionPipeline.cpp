@@ -0,0 +1,245 @@
+/** @file ExpressionPipeline.cpp
+ * ExpressionPipeline runs conversion, evaluation and formatting of an expression stream as concurrent stages.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ExpressionPipeline.h"
+
+ExpressionPipeline::ExpressionPipeline(InfixToPostfixEvaluation& expressionConverter, const VariableColumns& rows,
+    std::size_t expressionsPerBatch, std::size_t queueCapacity)
+    : converter(expressionConverter), context(expressionConverter.getEvaluationContext()), variableRows(rows),
+    batchSize(expressionsPerBatch > 0 ? expressionsPerBatch : 1), convertQueue(queueCapacity),
+    evaluateQueue(queueCapacity), formatQueue(queueCapacity), writeQueue(queueCapacity), failed(false), errorCount(0)
+{ } // end constructor
+
+void ExpressionPipeline::backOff(unsigned& attempts)
+{
+    if (++attempts < 64)
+    {
+        std::this_thread::yield();
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+} // end backOff
+
+bool ExpressionPipeline::push(BatchQueue& queue, const std::shared_ptr<Batch>& batch)
+{
+    unsigned attempts = 0;
+    while (!queue.enqueue(batch))  // Backpressure: wait for the next stage to take a batch
+    {
+        if (failed.load(std::memory_order_relaxed)) return false;
+        backOff(attempts);
+    }
+    return true;
+} // end push
+
+bool ExpressionPipeline::pop(BatchQueue& queue, std::shared_ptr<Batch>& batch)
+{
+    unsigned attempts = 0;
+    while (!queue.tryDequeue(batch))
+    {
+        if (failed.load(std::memory_order_relaxed)) return false;
+        backOff(attempts);
+    }
+    return true;
+} // end pop
+
+void ExpressionPipeline::recordFailure() noexcept
+{
+    if (!failed.exchange(true))
+    {
+        failure = std::current_exception();
+    }
+} // end recordFailure
+
+void ExpressionPipeline::readStage(std::istream& input)
+{
+    try
+    {
+        std::shared_ptr<Batch> batch;
+        std::string line;
+        while (std::getline(input, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();  // Accept Windows line endings
+            if (line.empty()) continue;
+
+            if (!batch)
+            {
+                batch = std::make_shared<Batch>();
+                batch->startTime = Clock::now();
+                batch->lines.reserve(batchSize);
+            }
+            batch->lines.push_back(std::move(line));
+            if (batch->lines.size() == batchSize)
+            {
+                if (!push(convertQueue, batch)) return;
+                batch.reset();
+            }
+        }
+        if (batch && !push(convertQueue, batch)) return;
+        push(convertQueue, nullptr);
+    }
+    catch (...)
+    {
+        recordFailure();
+    }
+} // end readStage
+
+void ExpressionPipeline::convertStage()
+{
+    try
+    {
+        std::shared_ptr<Batch> batch;
+        while (pop(convertQueue, batch) && batch)
+        {
+            batch->programs.reserve(batch->lines.size());
+            for (const std::string& line : batch->lines)
+            {
+                converter.convertInfixToPostfix(line);
+                batch->programs.push_back(converter.getCompiledProgram());
+            }
+            if (!push(evaluateQueue, batch)) return;
+        }
+        if (!failed.load()) push(evaluateQueue, nullptr);
+    }
+    catch (...)
+    {
+        recordFailure();
+    }
+} // end convertStage
+
+void ExpressionPipeline::evaluateStage()
+{
+    try
+    {
+        std::size_t resultsPerExpression = variableRows.getRowCount() > 0 ? variableRows.getRowCount() : 1;
+        std::size_t errorWordsPerExpression = (resultsPerExpression + 63) / 64;
+        std::shared_ptr<Batch> batch;
+        while (pop(evaluateQueue, batch) && batch)
+        {
+            batch->results.resize(batch->programs.size() * resultsPerExpression);
+            batch->rowErrors.assign(batch->programs.size() * errorWordsPerExpression, 0);
+            batch->errors.resize(batch->programs.size());
+            for (std::size_t i = 0; i < batch->programs.size(); ++i)
+            {
+                try
+                {
+                    if (variableRows.getRowCount() == 0)
+                    {
+                        batch->results[i] = context.evaluate(*batch->programs[i]);
+                    }
+                    else
+                    {
+                        BatchEvaluationResult rowResults = batch->programs[i]->tryEvaluateBatch(variableRows);
+                        if (rowResults.status != EvaluationStatus::Ok)
+                        {
+                            // Throws the error, naming a missing variable
+                            batch->programs[i]->evaluateBatch(variableRows, batch->results.data() + i * resultsPerExpression);
+                        }
+                        std::copy(rowResults.values.begin(), rowResults.values.end(),
+                            batch->results.begin() + i * resultsPerExpression);
+                        std::copy(rowResults.rowErrors.begin(), rowResults.rowErrors.end(),
+                            batch->rowErrors.begin() + i * errorWordsPerExpression);
+                        if (rowResults.errorCount > 0) ++errorCount;
+                    }
+                }
+                catch (const std::runtime_error& error)
+                {
+                    batch->errors[i] = error.what();
+                    ++errorCount;
+                }
+            }
+            if (!push(formatQueue, batch)) return;
+        }
+        if (!failed.load()) push(formatQueue, nullptr);
+    }
+    catch (...)
+    {
+        recordFailure();
+    }
+} // end evaluateStage
+
+void ExpressionPipeline::formatStage()
+{
+    try
+    {
+        std::size_t resultsPerExpression = variableRows.getRowCount() > 0 ? variableRows.getRowCount() : 1;
+        std::size_t errorWordsPerExpression = (resultsPerExpression + 63) / 64;
+        std::ostringstream text;
+        std::shared_ptr<Batch> batch;
+        while (pop(formatQueue, batch) && batch)
+        {
+            text.str(std::string());
+            for (std::size_t i = 0; i < batch->programs.size(); ++i)
+            {
+                text << batch->programs[i]->getPostfixText() << '\t';
+                if (!batch->errors[i].empty())
+                {
+                    text << "error: " << batch->errors[i];
+                }
+                else
+                {
+                    for (std::size_t row = 0; row < resultsPerExpression; ++row)
+                    {
+                        if (row != 0) text << '\t';
+                        if ((batch->rowErrors[i * errorWordsPerExpression + row / 64] >> (row % 64)) & 1)
+                        {
+                            text << "error: " << EvaluationResult::describe(EvaluationStatus::DivisionByZero);
+                        }
+                        else
+                        {
+                            text << batch->results[i * resultsPerExpression + row];
+                        }
+                    }
+                }
+                text << '\n';
+            }
+            batch->text = text.str();
+            batch->programs.clear();  // Release programs the cache or converter no longer holds
+            if (!push(writeQueue, batch)) return;
+        }
+        if (!failed.load()) push(writeQueue, nullptr);
+    }
+    catch (...)
+    {
+        recordFailure();
+    }
+} // end formatStage
+
+ExpressionPipeline::Summary ExpressionPipeline::run(std::istream& input, std::ostream& output)
+{
+    Summary summary = {};
+    std::thread reader(&ExpressionPipeline::readStage, this, std::ref(input));
+    std::thread converterThread(&ExpressionPipeline::convertStage, this);
+    std::thread evaluatorThread(&ExpressionPipeline::evaluateStage, this);
+    std::thread formatterThread(&ExpressionPipeline::formatStage, this);
+
+    // The calling thread is the last stage, writing batches in the order they were read
+    try
+    {
+        std::shared_ptr<Batch> batch;
+        while (pop(writeQueue, batch) && batch)
+        {
+            output << batch->text;
+            double latency = std::chrono::duration<double, std::micro>(Clock::now() - batch->startTime).count();
+            summary.expressionCount += batch->lines.size();
+            summary.latenciesMicroseconds.insert(summary.latenciesMicroseconds.end(), batch->lines.size(), latency);
+        }
+    }
+    catch (...)
+    {
+        recordFailure();
+    }
+
+    reader.join();
+    converterThread.join();
+    evaluatorThread.join();
+    formatterThread.join();
+    if (failure) std::rethrow_exception(failure);
+
+    summary.errorCount = errorCount;
+    return summary;
+} // end run
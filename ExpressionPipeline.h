@@ -0,0 +1,168 @@
+/** @file ExpressionPipeline.h
+ * @class ExpressionPipeline
+ * Converts, evaluates and formats a stream of infix expressions in concurrent stages. A reader thread groups input
+ * lines into batches, then separate threads convert, evaluate and format each batch while the calling thread
+ * writes finished batches in input order. Stages hand whole batches to each other through bounded LockFreeQueues,
+ * so a slow stage makes the stages before it wait instead of letting batches pile up. Output is the same as
+ * ExpressionStreamProcessor::process. */
+
+#ifndef EXPRESSION_PIPELINE_
+#define EXPRESSION_PIPELINE_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InfixToPostfixEvaluation.h"
+#include "EvaluationContext.h"
+#include "LockFreeQueue.h"
+#include "VariableColumns.h"
+
+class ExpressionPipeline
+{
+public:
+    /** Number of expressions per batch when none is given. */
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 256;
+
+    /** Number of batches each queue between two stages holds when none is given. */
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 8;
+
+    /** Summary of one run. Latencies run from the moment a batch is read to the moment it is written. */
+    struct Summary
+    {
+        std::size_t expressionCount;
+        std::size_t errorCount;
+        std::vector<double> latenciesMicroseconds;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** A group of expressions moving through the stages. Each stage fills in its own part. */
+    struct Batch
+    {
+        /** When the reader started the batch. */
+        Clock::time_point startTime;
+
+        /** The infix expressions, filled by the reader. */
+        std::vector<std::string> lines;
+
+        /** The compiled program of each expression, filled by the convert stage. */
+        std::vector<std::shared_ptr<const PostfixProgram>> programs;
+
+        /** The results of each expression, one per row or a single one, filled by the evaluate stage. */
+        std::vector<double> results;
+
+        /** Bitmap of the rows of each expression that divided by zero, a word for every 64 rows of each
+         * expression, filled by the evaluate stage when there are rows. */
+        std::vector<std::uint64_t> rowErrors;
+
+        /** The error message of each expression, empty if it was evaluated, filled by the evaluate stage. */
+        std::vector<std::string> errors;
+
+        /** The output lines of the batch, filled by the format stage. */
+        std::string text;
+    };
+
+    /** Queue between two stages. A null batch marks the end of the stream. */
+    using BatchQueue = LockFreeQueue<std::shared_ptr<Batch>>;
+
+    /** Converts the expressions. Only the convert stage uses it while the pipeline runs. */
+    InfixToPostfixEvaluation& converter;
+
+    /** Variable values for expressions evaluated one at a time. Only the evaluate stage uses it. */
+    EvaluationContext context;
+
+    /** Rows to evaluate every expression against, used instead of the context when not empty. */
+    const VariableColumns& variableRows;
+
+    /** Maximum number of expressions per batch. */
+    std::size_t batchSize;
+
+    /** Queues between the reader, convert, evaluate and format stages and the writer. */
+    BatchQueue convertQueue;
+    BatchQueue evaluateQueue;
+    BatchQueue formatQueue;
+    BatchQueue writeQueue;
+
+    /** Set when a stage fails, so the other stages stop instead of waiting for it. */
+    std::atomic<bool> failed;
+
+    /** The first exception thrown by a stage, rethrown by run. */
+    std::exception_ptr failure;
+
+    /** Number of expressions that produced an error, counted by the evaluate stage. */
+    std::size_t errorCount;
+
+    /** Waits a little before trying a full or empty queue again: first by yielding, then by sleeping so an idle
+     * stage does not keep a core busy.
+     * @pre None
+     * @post attempts is increased.
+     * @param attempts The number of attempts made so far. */
+    static void backOff(unsigned& attempts);
+
+    /** Adds a batch to a queue, waiting while the queue is full.
+     * @pre None
+     * @post The batch is in the queue, unless a stage failed.
+     * @param queue The queue.
+     * @param batch The batch, or nullptr to mark the end of the stream.
+     * @return True if the batch was added, false if a stage failed. */
+    bool push(BatchQueue& queue, const std::shared_ptr<Batch>& batch);
+
+    /** Takes the next batch from a queue, waiting while the queue is empty.
+     * @pre None
+     * @post The batch is removed from the queue.
+     * @param queue The queue.
+     * @param batch Receives the batch, or nullptr at the end of the stream.
+     * @return True if a batch or the end marker was taken, false if a stage failed. */
+    bool pop(BatchQueue& queue, std::shared_ptr<Batch>& batch);
+
+    /** Records the exception being handled as the failure of the pipeline.
+     * @pre Called from a catch block.
+     * @post failed is true. */
+    void recordFailure() noexcept;
+
+    /** Reads lines of input into batches and passes them to the convert stage. */
+    void readStage(std::istream& input);
+
+    /** Converts the expressions of each batch into programs. */
+    void convertStage();
+
+    /** Evaluates the programs of each batch. */
+    void evaluateStage();
+
+    /** Formats the results of each batch into output lines. */
+    void formatStage();
+
+public:
+    /** Creates a pipeline.
+     * @param expressionConverter The evaluator used to convert expressions. Its variable values are used to
+     * evaluate expressions when there are no rows. It must not be used elsewhere while the pipeline runs.
+     * @param rows Rows to evaluate every expression against, or empty columns to use the converter's values.
+     * @param expressionsPerBatch The maximum number of expressions per batch.
+     * @param queueCapacity The number of batches each queue between two stages holds. */
+    ExpressionPipeline(InfixToPostfixEvaluation& expressionConverter, const VariableColumns& rows,
+        std::size_t expressionsPerBatch = DEFAULT_BATCH_SIZE, std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+    /** Converts, evaluates and formats every expression of a stream. Writes one line per expression: the postfix
+     * form, a tab, then the result, the results of every row separated by tabs, or "error: " and the error message.
+     * @pre input holds one infix expression per line. Blank lines are skipped. The pipeline has not run before.
+     * @post input is read to its end.
+     * @param input The stream of infix expressions.
+     * @param output The stream that receives the results.
+     * @return The number of expressions and errors, and the latency of each expression.
+     * @throws std::bad_alloc If a stage runs out of memory. */
+    Summary run(std::istream& input, std::ostream& output);
+}; // end ExpressionPipeline
+
+#include "ExpressionPipeline.cpp"
+#endif
@@ -0,0 +1,193 @@
+/** @file ExpressionStreamProcessor.cpp
+ * ExpressionStreamProcessor converts and evaluates a stream of infix expressions and reports throughput.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ExpressionStreamProcessor.h"
+
+ExpressionStreamProcessor::ExpressionStreamProcessor()
+{
+    evaluator.clearVariableValues();
+} // end default constructor
+
+void ExpressionStreamProcessor::readValuesFromFile(const std::string& filename)
+{
+    evaluator.readValuesFromFile(filename);
+} // end readValuesFromFile
+
+std::vector<VariableFileLoader::RowError> ExpressionStreamProcessor::loadVariableRows(const std::string& filename)
+{
+    return VariableFileLoader::loadFile(filename, variableRows);
+} // end loadVariableRows
+
+ExpressionStreamProcessor::Report ExpressionStreamProcessor::process(std::istream& input, std::ostream& output)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Report report = {};
+    std::vector<double> latencies;
+    BatchEvaluationResult rowResults;
+    std::string line;
+    Clock::time_point runStart = Clock::now();
+
+    while (std::getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();  // Accept Windows line endings
+        if (line.empty()) continue;
+
+        Clock::time_point expressionStart = Clock::now();
+        evaluator.convertInfixToPostfix(line);
+        output << evaluator.getPostfixExpressionView() << '\t';
+
+        try
+        {
+            if (variableRows.getRowCount() == 0)
+            {
+                output << evaluator.evaluatePostfixExpression();
+            }
+            else
+            {
+                rowResults = evaluator.tryEvaluatePostfixExpressionBatch(variableRows);
+                if (rowResults.status != EvaluationStatus::Ok)
+                {
+                    evaluator.evaluatePostfixExpressionBatch(variableRows);  // Throws the error, naming a missing variable
+                }
+                for (std::size_t row = 0; row < rowResults.values.size(); ++row)
+                {
+                    if (row != 0) output << '\t';
+                    if (rowResults.hasRowError(row))
+                    {
+                        output << "error: " << EvaluationResult::describe(EvaluationStatus::DivisionByZero);
+                    }
+                    else
+                    {
+                        output << rowResults.values[row];
+                    }
+                }
+                if (rowResults.errorCount > 0) ++report.errorCount;
+            }
+        }
+        catch (const std::runtime_error& error)
+        {
+            output << "error: " << error.what();
+            ++report.errorCount;
+        }
+        output << '\n';
+
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - expressionStart).count());
+    }
+
+    report.expressionCount = latencies.size();
+    summarize(report, latencies, std::chrono::duration<double>(Clock::now() - runStart).count());
+    return report;
+} // end process
+
+ExpressionStreamProcessor::Report ExpressionStreamProcessor::processPipelined(std::istream& input,
+    std::ostream& output, std::size_t batchSize)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point runStart = Clock::now();
+    ExpressionPipeline pipeline(evaluator, variableRows, batchSize);
+    ExpressionPipeline::Summary summary = pipeline.run(input, output);
+
+    Report report = {};
+    report.expressionCount = summary.expressionCount;
+    report.errorCount = summary.errorCount;
+    summarize(report, summary.latenciesMicroseconds, std::chrono::duration<double>(Clock::now() - runStart).count());
+    return report;
+} // end processPipelined
+
+void ExpressionStreamProcessor::summarize(Report& report, std::vector<double>& latencies, double elapsedSeconds)
+{
+    report.elapsedSeconds = elapsedSeconds;
+    report.expressionsPerSecond = report.elapsedSeconds > 0 ? report.expressionCount / report.elapsedSeconds : 0;
+    report.latencyP50Microseconds = findPercentile(latencies, 50);
+    report.latencyP90Microseconds = findPercentile(latencies, 90);
+    report.latencyP99Microseconds = findPercentile(latencies, 99);
+    report.latencyMaxMicroseconds = findPercentile(latencies, 100);
+} // end summarize
+
+double ExpressionStreamProcessor::findPercentile(std::vector<double>& latencies, double percentile)
+{
+    if (latencies.empty()) return 0;
+
+    // Nearest-rank percentile; nth_element avoids sorting every latency
+    std::size_t rank = static_cast<std::size_t>(percentile / 100.0 * (latencies.size() - 1) + 0.5);
+    std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies[rank];
+} // end findPercentile
+
+void ExpressionStreamProcessor::writeReport(const Report& report, std::ostream& output)
+{
+    output << "Expressions: " << report.expressionCount << " (" << report.errorCount << " errors) in "
+        << report.elapsedSeconds << " s, " << report.expressionsPerSecond << " expressions/s\n";
+    output << "Latency (us): p50 " << report.latencyP50Microseconds << ", p90 " << report.latencyP90Microseconds
+        << ", p99 " << report.latencyP99Microseconds << ", max " << report.latencyMaxMicroseconds << '\n';
+    POSTFIX_STATS(PostfixStatistics::writeSnapshot(PostfixStatistics::getSnapshot(), output));
+} // end writeReport
+
+int ExpressionStreamProcessor::runFromCommandLine(int argumentCount, char* arguments[])
+{
+    std::ios::sync_with_stdio(false);  // Streams do not need to stay in step with C stdio
+    std::cin.tie(nullptr);              // Do not flush stdout before every read
+
+    ExpressionStreamProcessor processor;
+    std::string expressionFile = "-";
+    bool pipelined = false;
+
+    try
+    {
+        for (int i = 0; i < argumentCount; ++i)
+        {
+            std::string argument = arguments[i];
+            if ((argument == "--values" || argument == "--rows") && i + 1 < argumentCount)
+            {
+                if (argument == "--values")
+                {
+                    processor.readValuesFromFile(arguments[++i]);
+                }
+                else
+                {
+                    for (const VariableFileLoader::RowError& rowError : processor.loadVariableRows(arguments[++i]))
+                    {
+                        std::cerr << "Skipped row " << rowError.lineNumber << ": " << rowError.message << '\n';
+                    }
+                }
+            }
+            else if (argument == "--pipeline")
+            {
+                pipelined = true;
+            }
+            else
+            {
+                expressionFile = argument;
+            }
+        }
+
+        Report report;
+        if (expressionFile == "-")
+        {
+            report = pipelined ? processor.processPipelined(std::cin, std::cout) : processor.process(std::cin, std::cout);
+        }
+        else
+        {
+            std::ifstream input(expressionFile);
+            if (!input)
+            {
+                throw std::runtime_error("Could not open file: " + expressionFile);
+            }
+            report = pipelined ? processor.processPipelined(input, std::cout) : processor.process(input, std::cout);
+        }
+
+        std::cout.flush();
+        writeReport(report, std::cerr);
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::cerr << "Error: " << error.what() << '\n';
+        return 1;
+    }
+    return 0;
+} // end runFromCommandLine
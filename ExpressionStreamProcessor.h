@@ -0,0 +1,121 @@
+/** @file ExpressionStreamProcessor.h
+ * @class ExpressionStreamProcessor
+ * Non-interactive driver that reads one infix expression per line from a stream, converts and evaluates each one,
+ * and writes the postfix form and result per line. Output is buffered and written with '\n' rather than flushing,
+ * and a throughput and latency report is produced at the end. Large streams can instead run through an
+ * ExpressionPipeline, which overlaps reading, conversion, evaluation, formatting and writing on separate threads. */
+
+#ifndef EXPRESSION_STREAM_PROCESSOR_
+#define EXPRESSION_STREAM_PROCESSOR_
+
+#include <cstddef>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "InfixToPostfixEvaluation.h"
+#include "VariableColumns.h"
+#include "VariableFileLoader.h"
+#include "PostfixStatistics.h"
+#include "ExpressionPipeline.h"
+
+class ExpressionStreamProcessor
+{
+public:
+    /** Summary of one processing run. Latencies cover converting, evaluating and formatting one expression. */
+    struct Report
+    {
+        std::size_t expressionCount;
+        std::size_t errorCount;
+        double elapsedSeconds;
+        double expressionsPerSecond;
+        double latencyP50Microseconds;
+        double latencyP90Microseconds;
+        double latencyP99Microseconds;
+        double latencyMaxMicroseconds;
+    };
+
+private:
+    /** Converts and evaluates the expressions. */
+    InfixToPostfixEvaluation evaluator;
+
+    /** Rows to evaluate every expression against, used instead of the evaluator's variable values when not empty. */
+    VariableColumns variableRows;
+
+    /** Fills in the throughput and latency fields of a report.
+     * @param report The report, with its expression count set.
+     * @param latencies The latency of each expression in microseconds. Reordered by the call.
+     * @param elapsedSeconds The duration of the run. */
+    static void summarize(Report& report, std::vector<double>& latencies, double elapsedSeconds);
+
+    /** Gets a percentile of a set of latencies.
+     * @param latencies The latencies in microseconds. Reordered by the call.
+     * @param percentile The percentile to find, between 0 and 100.
+     * @return The latency at the percentile, or 0 if there are none. */
+    static double findPercentile(std::vector<double>& latencies, double percentile);
+
+public:
+    /** Default constructor. Variable values start at 0. */
+    ExpressionStreamProcessor();
+
+    /** Reads the single row of variable values used to evaluate every expression.
+     * @pre The file contains at least six integer values.
+     * @post Later expressions are evaluated against these values.
+     * @param filename The name of the file containing variable values.
+     * @throws std::runtime_error If the file cannot be opened or does not contain enough values. */
+    void readValuesFromFile(const std::string& filename);
+
+    /** Loads many rows of variable values. Every expression is then evaluated against every row.
+     * @pre Each line of the file holds one row of six values.
+     * @post Later expressions are evaluated against all loaded rows.
+     * @param filename The name of the file containing rows of variable values.
+     * @return The errors of the rows that were skipped.
+     * @throws std::runtime_error If the file cannot be opened. */
+    std::vector<VariableFileLoader::RowError> loadVariableRows(const std::string& filename);
+
+    /** Converts and evaluates every expression of a stream. Writes one line per expression: the postfix form, a tab,
+     * then the result, the results of every row separated by tabs, or "error: " and the error message. With many
+     * rows, a row that divides by zero gets "error: Division by zero" in its own column and the other rows keep their
+     * results; the expression counts as one error.
+     * @pre input holds one infix expression per line. Blank lines are skipped.
+     * @post input is read to its end.
+     * @param input The stream of infix expressions.
+     * @param output The stream that receives the results.
+     * @return The throughput and latency report of the run. */
+    Report process(std::istream& input, std::ostream& output);
+
+    /** Converts and evaluates every expression of a stream like process, but in an ExpressionPipeline whose stages
+     * run on separate threads. The output is the same as the output of process.
+     * @pre input holds one infix expression per line. Blank lines are skipped.
+     * @post input is read to its end.
+     * @param input The stream of infix expressions.
+     * @param output The stream that receives the results.
+     * @param batchSize The number of expressions handed from one stage to the next at a time.
+     * @return The throughput and latency report of the run. Latencies are those of each expression's batch. */
+    Report processPipelined(std::istream& input, std::ostream& output,
+        std::size_t batchSize = ExpressionPipeline::DEFAULT_BATCH_SIZE);
+
+    /** Writes a report in a readable form.
+     * @pre None
+     * @post None
+     * @param report The report to write.
+     * @param output The stream that receives the report. */
+    static void writeReport(const Report& report, std::ostream& output);
+
+    /** Runs the streaming mode from command line arguments:
+     * [expressionFile | -] [--values file] [--rows file] [--pipeline]. Expressions are read from stdin when no file
+     * or "-" is given. --pipeline runs the stages on separate threads. Results go to stdout and the report to
+     * stderr.
+     * @pre None
+     * @post None
+     * @param argumentCount The number of arguments.
+     * @param arguments The arguments, not including the program name or the mode flag.
+     * @return The process exit code, 0 on success. */
+    static int runFromCommandLine(int argumentCount, char* arguments[]);
+}; // end ExpressionStreamProcessor
+
+#include "ExpressionStreamProcessor.cpp"
+#endif
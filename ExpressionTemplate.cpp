@@ -0,0 +1,217 @@
+/** @file ExpressionTemplate.cpp
+ * ExpressionTemplate evaluates formulas built from C++ expressions inline and writes their postfix form.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ExpressionTemplate.h"
+
+// Evaluates the derived term; the calls inline down to the arithmetic of the whole expression.
+template<class Derived>
+template<class ValueType>
+constexpr double ExpressionTerm<Derived>::evaluate(const ValueType variableValues[]) const
+{
+    return static_cast<const Derived&>(*this).evaluateTerm(variableValues);
+} // end evaluate
+
+// Writes the postfix text, spaced only if some token is longer than one character.
+template<class Derived>
+std::string ExpressionTerm<Derived>::toPostfix() const
+{
+    const Derived& term = static_cast<const Derived&>(*this);
+    bool spaced = term.hasLongToken();
+    std::string text;
+    term.appendPostfix(text, spaced);
+    if (spaced && !text.empty()) text.pop_back();  // Every token is followed by a space
+    return text;
+} // end toPostfix
+
+// Compiles the postfix text into a runtime program.
+template<class Derived>
+PostfixProgram ExpressionTerm<Derived>::toProgram() const
+{
+    return PostfixProgram(toPostfix());
+} // end toProgram
+
+// Reads the value of the variable from its slot.
+template<char Name>
+template<class ValueType>
+constexpr double VariableTerm<Name>::evaluateTerm(const ValueType variableValues[]) const
+{
+    return static_cast<double>(variableValues[SLOT]);
+} // end evaluateTerm
+
+// Writes the variable name.
+template<char Name>
+void VariableTerm<Name>::appendPostfix(std::string& text, bool spaced) const
+{
+    text += Name;
+    if (spaced) text += ' ';
+} // end appendPostfix
+
+// Variable names a-f are one character.
+template<char Name>
+constexpr bool VariableTerm<Name>::hasLongToken() const noexcept
+{
+    return false;
+} // end hasLongToken
+
+constexpr ConstantTerm::ConstantTerm(double constantValue) noexcept : value(constantValue)
+{ } // end constructor
+
+// Gives the value of the constant whatever the variables are.
+template<class ValueType>
+constexpr double ConstantTerm::evaluateTerm(const ValueType[]) const
+{
+    return value;
+} // end evaluateTerm
+
+void ConstantTerm::appendPostfix(std::string& text, bool spaced) const
+{
+    if (!std::isfinite(value))  // Would be read back as a variable named inf or nan
+    {
+        throw std::runtime_error("Constant has no postfix form: " + std::to_string(value));
+    }
+    char digits[32];
+    if (value == 0 && std::signbit(value))  // 0 minus 0 is +0, so write 0 times (0 minus 1) to keep the sign
+    {
+        text += spaced ? "0 0 1 - * " : "001-*";
+        return;
+    }
+    if (value < 0)  // The converter has no unary minus, so write 0 minus the magnitude
+    {
+        text += spaced ? "0 " : "0";
+        std::to_chars_result written = std::to_chars(digits, digits + sizeof(digits), -value);
+        text.append(digits, written.ptr);
+        text += spaced ? " - " : "-";
+        return;
+    }
+    std::to_chars_result written = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, written.ptr);
+    if (spaced) text += ' ';
+} // end appendPostfix
+
+bool ConstantTerm::hasLongToken() const
+{
+    char digits[32];
+    std::to_chars_result written = std::to_chars(digits, digits + sizeof(digits), std::fabs(value));
+    return written.ptr - digits > 1;
+} // end hasLongToken
+
+// Stores the operands by value; terms are small and their types carry the structure.
+template<char Operator, class Left, class Right>
+constexpr BinaryTerm<Operator, Left, Right>::BinaryTerm(const Left& leftTerm, const Right& rightTerm) noexcept
+    : left(leftTerm), right(rightTerm)
+{ } // end constructor
+
+// Applies the operator, chosen at compile time, to the values of both operands.
+template<char Operator, class Left, class Right>
+template<class ValueType>
+constexpr double BinaryTerm<Operator, Left, Right>::evaluateTerm(const ValueType variableValues[]) const
+{
+    double operand1 = left.evaluateTerm(variableValues);
+    double operand2 = right.evaluateTerm(variableValues);
+    if constexpr (Operator == '+') return operand1 + operand2;
+    else if constexpr (Operator == '-') return operand1 - operand2;
+    else if constexpr (Operator == '*') return operand1 * operand2;
+    else
+    {
+        if (operand2 == 0) throw std::runtime_error("Division by zero");
+        return operand1 / operand2;
+    }
+} // end evaluateTerm
+
+// Writes the operands in order, then the operator.
+template<char Operator, class Left, class Right>
+void BinaryTerm<Operator, Left, Right>::appendPostfix(std::string& text, bool spaced) const
+{
+    left.appendPostfix(text, spaced);
+    right.appendPostfix(text, spaced);
+    text += Operator;
+    if (spaced) text += ' ';
+} // end appendPostfix
+
+// Checks both operands for constants written with more than one character.
+template<char Operator, class Left, class Right>
+bool BinaryTerm<Operator, Left, Right>::hasLongToken() const
+{
+    return left.hasLongToken() || right.hasLongToken();
+} // end hasLongToken
+
+template<char Name>
+constexpr VariableTerm<Name> var() noexcept
+{
+    return VariableTerm<Name>();
+} // end var
+
+template<class Left, class Right>
+constexpr BinaryTerm<'+', Left, Right> operator+(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept
+{
+    return BinaryTerm<'+', Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+} // end operator+
+
+template<class Left, class Right>
+constexpr BinaryTerm<'-', Left, Right> operator-(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept
+{
+    return BinaryTerm<'-', Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+} // end operator-
+
+template<class Left, class Right>
+constexpr BinaryTerm<'*', Left, Right> operator*(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept
+{
+    return BinaryTerm<'*', Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+} // end operator*
+
+template<class Left, class Right>
+constexpr BinaryTerm<'/', Left, Right> operator/(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept
+{
+    return BinaryTerm<'/', Left, Right>(static_cast<const Left&>(left), static_cast<const Right&>(right));
+} // end operator/
+
+template<class Left>
+constexpr BinaryTerm<'+', Left, ConstantTerm> operator+(const ExpressionTerm<Left>& left, double right) noexcept
+{
+    return left + ConstantTerm(right);
+} // end operator+
+
+template<class Left>
+constexpr BinaryTerm<'-', Left, ConstantTerm> operator-(const ExpressionTerm<Left>& left, double right) noexcept
+{
+    return left - ConstantTerm(right);
+} // end operator-
+
+template<class Left>
+constexpr BinaryTerm<'*', Left, ConstantTerm> operator*(const ExpressionTerm<Left>& left, double right) noexcept
+{
+    return left * ConstantTerm(right);
+} // end operator*
+
+template<class Left>
+constexpr BinaryTerm<'/', Left, ConstantTerm> operator/(const ExpressionTerm<Left>& left, double right) noexcept
+{
+    return left / ConstantTerm(right);
+} // end operator/
+
+template<class Right>
+constexpr BinaryTerm<'+', ConstantTerm, Right> operator+(double left, const ExpressionTerm<Right>& right) noexcept
+{
+    return ConstantTerm(left) + right;
+} // end operator+
+
+template<class Right>
+constexpr BinaryTerm<'-', ConstantTerm, Right> operator-(double left, const ExpressionTerm<Right>& right) noexcept
+{
+    return ConstantTerm(left) - right;
+} // end operator-
+
+template<class Right>
+constexpr BinaryTerm<'*', ConstantTerm, Right> operator*(double left, const ExpressionTerm<Right>& right) noexcept
+{
+    return ConstantTerm(left) * right;
+} // end operator*
+
+template<class Right>
+constexpr BinaryTerm<'/', ConstantTerm, Right> operator/(double left, const ExpressionTerm<Right>& right) noexcept
+{
+    return ConstantTerm(left) / right;
+} // end operator/
@@ -0,0 +1,165 @@
+/** @file ExpressionTemplate.h
+ * @class ExpressionTerm
+ * Expression templates for formulas built in C++ code. var<'a'>() + var<'b'>() * var<'c'>() builds a small tree of
+ * types instead of a string; evaluate inlines the whole tree into straight-line arithmetic over the same table of
+ * values indexed by slot that PostfixProgram uses, so nothing is parsed, converted or interpreted. Variables are a-f,
+ * checked at compile time, and constants are doubles. toPostfix gives the postfix text convertInfixToPostfix would
+ * produce for the same formula, for logging and for passing the formula to the runtime evaluators.
+ *
+ * Usage: auto formula = var<'a'>() * (var<'b'>() + 2.5); double result = formula.evaluate(values); */
+
+#ifndef EXPRESSION_TEMPLATE_
+#define EXPRESSION_TEMPLATE_
+
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "PostfixProgram.h"
+#include "SymbolTable.h"
+
+/** Base of every term of an expression template. Derived is the term itself, so the whole tree is known at compile
+ * time and nothing is virtual. */
+template<class Derived>
+class ExpressionTerm
+{
+public:
+    /** Evaluates the expression against a table of variable values. Inlines to the arithmetic of the expression.
+     * @pre variableValues holds the values of variables a-f.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If division by zero occurs. */
+    template<class ValueType>
+    constexpr double evaluate(const ValueType variableValues[]) const;
+
+    /** Gets the postfix form of the expression. Tokens are separated by spaces only if a constant takes more than
+     * one character, as in the postfix text of convertInfixToPostfix.
+     * @pre None
+     * @post None
+     * @return The postfix text, such as "abc*+".
+     * @throws std::runtime_error If a constant is infinite or NaN, which postfix text cannot represent. */
+    std::string toPostfix() const;
+
+    /** Creates the equivalent runtime program.
+     * @pre None
+     * @post None
+     * @return A PostfixProgram compiled from the postfix text.
+     * @throws std::runtime_error If a constant is infinite or NaN. */
+    PostfixProgram toProgram() const;
+}; // end ExpressionTerm
+
+/** A variable a-f. */
+template<char Name>
+class VariableTerm : public ExpressionTerm<VariableTerm<Name>>
+{
+    static_assert(Name >= 'a' && Name < 'a' + static_cast<int>(SymbolTable::PREDEFINED_COUNT),
+        "Expression template variables must be a-f");
+
+public:
+    /** The slot of the variable. */
+    static constexpr std::uint32_t SLOT = static_cast<std::uint32_t>(Name - 'a');
+
+    /** Gets the value of the variable. */
+    template<class ValueType>
+    constexpr double evaluateTerm(const ValueType variableValues[]) const;
+
+    /** Appends the variable to postfix text. */
+    void appendPostfix(std::string& text, bool spaced) const;
+
+    /** Checks whether the term writes a token longer than one character. */
+    constexpr bool hasLongToken() const noexcept;
+}; // end VariableTerm
+
+/** A numeric constant. */
+class ConstantTerm : public ExpressionTerm<ConstantTerm>
+{
+private:
+    /** The value of the constant. */
+    double value;
+
+public:
+    /** Creates a constant.
+     * @param constantValue The value. Negative constants are written as 0 minus their magnitude in postfix text,
+     * since the converter has no unary minus, and -0 as 0 times (0 minus 1). */
+    constexpr explicit ConstantTerm(double constantValue) noexcept;
+
+    /** Gets the value of the constant. */
+    template<class ValueType>
+    constexpr double evaluateTerm(const ValueType variableValues[]) const;
+
+    /** Appends the constant to postfix text in its shortest exact form.
+     * @throws std::runtime_error If the constant is infinite or NaN. */
+    void appendPostfix(std::string& text, bool spaced) const;
+
+    /** Checks whether the term writes a token longer than one character. */
+    bool hasLongToken() const;
+}; // end ConstantTerm
+
+/** An operator +,-,*,/ applied to two terms. */
+template<char Operator, class Left, class Right>
+class BinaryTerm : public ExpressionTerm<BinaryTerm<Operator, Left, Right>>
+{
+    static_assert(Operator == '+' || Operator == '-' || Operator == '*' || Operator == '/',
+        "Expression template operators must be +,-,*,/");
+
+private:
+    /** The left operand. */
+    Left left;
+
+    /** The right operand. */
+    Right right;
+
+public:
+    /** Creates the term from its operands. */
+    constexpr BinaryTerm(const Left& leftTerm, const Right& rightTerm) noexcept;
+
+    /** Applies the operator to the values of the operands.
+     * @throws std::runtime_error If division by zero occurs. */
+    template<class ValueType>
+    constexpr double evaluateTerm(const ValueType variableValues[]) const;
+
+    /** Appends both operands and then the operator to postfix text. */
+    void appendPostfix(std::string& text, bool spaced) const;
+
+    /** Checks whether either operand writes a token longer than one character. */
+    bool hasLongToken() const;
+}; // end BinaryTerm
+
+/** Creates a variable term.
+ * @return The term of variable Name, one of a-f. */
+template<char Name>
+constexpr VariableTerm<Name> var() noexcept;
+
+/** Operators that combine two terms, or a term and a constant, into a BinaryTerm. */
+template<class Left, class Right>
+constexpr BinaryTerm<'+', Left, Right> operator+(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept;
+template<class Left, class Right>
+constexpr BinaryTerm<'-', Left, Right> operator-(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept;
+template<class Left, class Right>
+constexpr BinaryTerm<'*', Left, Right> operator*(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept;
+template<class Left, class Right>
+constexpr BinaryTerm<'/', Left, Right> operator/(const ExpressionTerm<Left>& left, const ExpressionTerm<Right>& right) noexcept;
+
+template<class Left>
+constexpr BinaryTerm<'+', Left, ConstantTerm> operator+(const ExpressionTerm<Left>& left, double right) noexcept;
+template<class Left>
+constexpr BinaryTerm<'-', Left, ConstantTerm> operator-(const ExpressionTerm<Left>& left, double right) noexcept;
+template<class Left>
+constexpr BinaryTerm<'*', Left, ConstantTerm> operator*(const ExpressionTerm<Left>& left, double right) noexcept;
+template<class Left>
+constexpr BinaryTerm<'/', Left, ConstantTerm> operator/(const ExpressionTerm<Left>& left, double right) noexcept;
+
+template<class Right>
+constexpr BinaryTerm<'+', ConstantTerm, Right> operator+(double left, const ExpressionTerm<Right>& right) noexcept;
+template<class Right>
+constexpr BinaryTerm<'-', ConstantTerm, Right> operator-(double left, const ExpressionTerm<Right>& right) noexcept;
+template<class Right>
+constexpr BinaryTerm<'*', ConstantTerm, Right> operator*(double left, const ExpressionTerm<Right>& right) noexcept;
+template<class Right>
+constexpr BinaryTerm<'/', ConstantTerm, Right> operator/(double left, const ExpressionTerm<Right>& right) noexcept;
+
+#include "ExpressionTemplate.cpp"
+#endif
@@ -0,0 +1,64 @@
+/** @file ExpressionTokenizer.cpp
+ * ExpressionTokenizer reads names, literals and operators from an expression with one pass over its characters.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ExpressionTokenizer.h"
+
+ExpressionTokenizer::ExpressionTokenizer(std::string_view text) noexcept : expression(text), position(0)
+{ } // end constructor
+
+bool ExpressionTokenizer::next(Token& token) noexcept
+{
+    // Skip the whitespace before the token
+    while (position < expression.size() && std::isspace(static_cast<unsigned char>(expression[position])))
+    {
+        ++position;
+    }
+    if (position == expression.size()) return false;
+
+    std::size_t start = position;
+    unsigned char currentChar = static_cast<unsigned char>(expression[position]);
+    token.value = 0;
+
+    if (std::isalpha(currentChar))  // Variable name
+    {
+        ++position;
+        while (position < expression.size() &&
+            (std::isalnum(static_cast<unsigned char>(expression[position])) || expression[position] == '_'))
+        {
+            ++position;
+        }
+        token.kind = TokenKind::Identifier;
+    }
+    else if (std::isdigit(currentChar) || (currentChar == '.' && position + 1 < expression.size() &&
+        std::isdigit(static_cast<unsigned char>(expression[position + 1]))))  // Literal
+    {
+        // from_chars reads the longest valid number, so "1.2.3" is read as 1.2 followed by .3
+        std::from_chars_result parsed = std::from_chars(expression.data() + position,
+            expression.data() + expression.size(), token.value, std::chars_format::general);
+        position = static_cast<std::size_t>(parsed.ptr - expression.data());
+        token.kind = parsed.ec == std::errc() ? TokenKind::Number : TokenKind::Invalid;
+        if (position == start) ++position;  // Always move forward
+    }
+    else
+    {
+        ++position;
+        switch (currentChar)
+        {
+        case '+': case '-': case '*': case '/': token.kind = TokenKind::Operator; break;
+        case '(': token.kind = TokenKind::LeftParenthesis; break;
+        case ')': token.kind = TokenKind::RightParenthesis; break;
+        default: token.kind = TokenKind::Invalid; break;
+        }
+    }
+
+    token.text = expression.substr(start, position - start);
+    return true;
+} // end next
+
+bool ExpressionTokenizer::isOperand(const Token& token) noexcept
+{
+    return token.kind == TokenKind::Identifier || token.kind == TokenKind::Number;
+} // end isOperand
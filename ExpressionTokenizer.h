@@ -0,0 +1,72 @@
+/** @file ExpressionTokenizer.h
+ * @class ExpressionTokenizer
+ * Splits an infix or postfix expression into tokens: variable names of any length, integer and floating-point
+ * literals, the operators +,-,*,/ and parentheses. Whitespace separates tokens and is otherwise ignored. Tokens
+ * refer to the text of the expression without copying it, so the expression must outlive them. */
+
+#ifndef EXPRESSION_TOKENIZER_
+#define EXPRESSION_TOKENIZER_
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+class ExpressionTokenizer
+{
+public:
+    /** Kinds of tokens. */
+    enum class TokenKind
+    {
+        Identifier,        // Variable name: a letter followed by letters, digits or underscores
+        Number,            // Integer or floating-point literal
+        Operator,          // One of +,-,*,/
+        LeftParenthesis,
+        RightParenthesis,
+        Invalid            // Any other character
+    };
+
+    /** A single token. */
+    struct Token
+    {
+        /** The kind of token. */
+        TokenKind kind;
+
+        /** The characters of the token within the expression. */
+        std::string_view text;
+
+        /** The value of a Number token, otherwise 0. */
+        double value;
+    };
+
+private:
+    /** The expression being split. */
+    std::string_view expression;
+
+    /** Position of the next character to read. */
+    std::size_t position;
+
+public:
+    /** Creates a tokenizer positioned at the start of an expression.
+     * @pre The expression outlives the tokenizer and its tokens.
+     * @post The next token read is the first token of the expression.
+     * @param text The expression to split. */
+    explicit ExpressionTokenizer(std::string_view text) noexcept;
+
+    /** Reads the next token.
+     * @pre None
+     * @post The tokenizer is positioned after the token.
+     * @param token Receives the token.
+     * @return True if a token was read, false at the end of the expression. */
+    bool next(Token& token) noexcept;
+
+    /** Checks whether a token is a variable or a literal.
+     * @pre None
+     * @post None
+     * @param token The token to check.
+     * @return True for Identifier and Number tokens. */
+    static bool isOperand(const Token& token) noexcept;
+}; // end ExpressionTokenizer
+
+#include "ExpressionTokenizer.cpp"
+#endif
@@ -0,0 +1,206 @@
+/** @file IncrementalEvaluator.cpp
+ * IncrementalEvaluator caches the value of every subexpression and recomputes only what a variable change affects.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "IncrementalEvaluator.h"
+
+IncrementalEvaluator::IncrementalEvaluator() : updateGeneration(1), lastUpdateCount(0)
+{
+    converter.setOptimizationEnabled(false);  // The shared graph already merges repeated subexpressions
+} // end default constructor
+
+IncrementalEvaluator::IncrementalEvaluator(ExpressionDag::Options options)
+    : dag(options), updateGeneration(1), lastUpdateCount(0)
+{
+    converter.setOptimizationEnabled(false);
+} // end constructor
+
+std::uint32_t IncrementalEvaluator::slotOf(std::string_view name)
+{
+    return converter.getSymbolTable()->intern(name);
+} // end slotOf
+
+std::shared_ptr<SymbolTable> IncrementalEvaluator::getSymbolTable() const noexcept
+{
+    return converter.getSymbolTable();
+} // end getSymbolTable
+
+bool IncrementalEvaluator::computeNode(std::size_t id)
+{
+    const ExpressionDag::Node& node = dag.getNode(id);
+    double value = 0;
+    NodeStatus status = NodeStatus::Ok;
+
+    switch (node.kind)
+    {
+    case ExpressionDag::NodeKind::Variable:
+        value = node.slot < variableValues.size() ? variableValues[node.slot] : 0;
+        break;
+    case ExpressionDag::NodeKind::Constant:
+        value = node.value;
+        break;
+    default:
+    {
+        if (nodeStatuses[node.left] != NodeStatus::Ok || nodeStatuses[node.right] != NodeStatus::Ok)
+        {
+            status = NodeStatus::DivisionByZero;  // An operand already failed
+            break;
+        }
+
+        double operand1 = nodeValues[node.left];
+        double operand2 = nodeValues[node.right];
+        switch (node.kind)
+        {
+        case ExpressionDag::NodeKind::Add: value = operand1 + operand2; break;
+        case ExpressionDag::NodeKind::Subtract: value = operand1 - operand2; break;
+        case ExpressionDag::NodeKind::Multiply: value = operand1 * operand2; break;
+        default:
+            if (operand2 == 0) status = NodeStatus::DivisionByZero;
+            else value = operand1 / operand2;
+            break;
+        }
+        break;
+    }
+    }
+
+    // Compare bit patterns so a change of sign of zero or a new NaN still counts as a change
+    bool changed = status != nodeStatuses[id] || std::memcmp(&value, &nodeValues[id], sizeof(value)) != 0;
+    nodeValues[id] = value;
+    nodeStatuses[id] = status;
+    return changed;
+} // end computeNode
+
+void IncrementalEvaluator::registerNewNodes(std::size_t firstNewNode)
+{
+    nodeValues.resize(dag.size(), 0);
+    nodeStatuses.resize(dag.size(), NodeStatus::Ok);
+    dependents.resize(dag.size());
+    queuedGenerations.resize(dag.size(), 0);
+
+    // New nodes only depend on nodes with smaller ids, which already have values
+    for (std::size_t id = firstNewNode; id < dag.size(); ++id)
+    {
+        const ExpressionDag::Node& node = dag.getNode(id);
+        if (node.kind == ExpressionDag::NodeKind::Variable)
+        {
+            if (node.slot >= variableNodes.size()) variableNodes.resize(node.slot + 1, ExpressionDag::NO_NODE);
+            variableNodes[node.slot] = id;
+        }
+        else if (node.left != ExpressionDag::NO_NODE)
+        {
+            dependents[node.left].push_back(id);
+            if (node.right != node.left) dependents[node.right].push_back(id);
+        }
+        computeNode(id);
+    }
+} // end registerNewNodes
+
+IncrementalEvaluator::ExpressionId IncrementalEvaluator::addExpression(const PostfixProgram& program)
+{
+    std::size_t firstNewNode = dag.size();
+    std::size_t root;
+    try
+    {
+        root = dag.addProgram(program);
+    }
+    catch (...)
+    {
+        registerNewNodes(firstNewNode);  // Nodes added before the error can be shared by later expressions
+        throw;
+    }
+    registerNewNodes(firstNewNode);
+
+    expressionRoots.push_back(root);
+    return expressionRoots.size() - 1;
+} // end addExpression
+
+IncrementalEvaluator::ExpressionId IncrementalEvaluator::addExpression(const std::string& infixExpression)
+{
+    converter.convertInfixToPostfix(infixExpression);
+    return addExpression(*converter.getCompiledProgram());
+} // end addExpression
+
+std::size_t IncrementalEvaluator::getExpressionCount() const noexcept
+{
+    return expressionRoots.size();
+} // end getExpressionCount
+
+void IncrementalEvaluator::setVariable(std::uint32_t slot, double value)
+{
+    if (slot >= variableValues.size()) variableValues.resize(slot + 1, 0);
+    variableValues[slot] = value;
+    lastUpdateCount = 0;
+
+    if (slot >= variableNodes.size() || variableNodes[slot] == ExpressionDag::NO_NODE) return;  // No expression uses it
+
+    // A new generation marks every node unqueued without touching the stamps; reset them once it wraps around
+    if (++updateGeneration == 0)
+    {
+        std::fill(queuedGenerations.begin(), queuedGenerations.end(), 0);
+        updateGeneration = 1;
+    }
+
+    // Recompute dirty nodes smallest id first, so every operand is current before the nodes that use it
+    dirtyNodes.clear();
+    dirtyNodes.push_back(variableNodes[slot]);
+    queuedGenerations[variableNodes[slot]] = updateGeneration;
+
+    while (!dirtyNodes.empty())
+    {
+        std::pop_heap(dirtyNodes.begin(), dirtyNodes.end(), std::greater<std::size_t>());
+        std::size_t id = dirtyNodes.back();
+        dirtyNodes.pop_back();
+        ++lastUpdateCount;
+
+        if (!computeNode(id)) continue;  // Nodes above an unchanged value stay valid
+
+        for (std::size_t dependent : dependents[id])
+        {
+            if (queuedGenerations[dependent] != updateGeneration)
+            {
+                queuedGenerations[dependent] = updateGeneration;
+                dirtyNodes.push_back(dependent);
+                std::push_heap(dirtyNodes.begin(), dirtyNodes.end(), std::greater<std::size_t>());
+            }
+        }
+    }
+} // end setVariable
+
+void IncrementalEvaluator::setVariable(const std::string& name, double value)
+{
+    setVariable(slotOf(name), value);
+} // end setVariable
+
+void IncrementalEvaluator::setVariable(char name, double value)
+{
+    setVariable(slotOf(std::string_view(&name, 1)), value);
+} // end setVariable
+
+double IncrementalEvaluator::getVariable(const std::string& name) const
+{
+    if (!SymbolTable::isValidName(name))
+    {
+        throw PrecondViolatedExcept("getVariable() called with an invalid variable name: " + name);
+    }
+    std::uint32_t slot = converter.getSymbolTable()->find(name);
+    return slot < variableValues.size() ? variableValues[slot] : 0;
+} // end getVariable
+
+double IncrementalEvaluator::getValue(ExpressionId expression) const
+{
+    if (expression >= expressionRoots.size())
+    {
+        throw PrecondViolatedExcept("getValue() called with an unknown expression.");
+    }
+
+    std::size_t root = expressionRoots[expression];
+    if (nodeStatuses[root] == NodeStatus::DivisionByZero) throw std::runtime_error("Division by zero");
+    return nodeValues[root];
+} // end getValue
+
+std::size_t IncrementalEvaluator::getLastUpdateCount() const noexcept
+{
+    return lastUpdateCount;
+} // end getLastUpdateCount
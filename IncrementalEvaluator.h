@@ -0,0 +1,187 @@
+/** @file IncrementalEvaluator.h
+ * @class IncrementalEvaluator
+ * Keeps many expressions up to date against one shared table of variable values. All expressions are stored in a
+ * single ExpressionDag, so a subexpression used by several expressions is stored and computed once, and the value
+ * of every node is cached. Changing a variable recomputes only the nodes that depend on it, in topological order,
+ * and stops early along paths whose value did not change. Not safe for concurrent use. */
+
+#ifndef INCREMENTAL_EVALUATOR_
+#define INCREMENTAL_EVALUATOR_
+
+#include <cstddef>
+#include <cstdint>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ExpressionDag.h"
+#include "PostfixProgram.h"
+#include "InfixToPostfixEvaluation.h"
+#include "PrecondViolatedExcept.h"
+
+class IncrementalEvaluator
+{
+public:
+    /** Identifies an expression registered with the evaluator. */
+    using ExpressionId = std::size_t;
+
+private:
+    /** Outcome of computing a node. */
+    enum class NodeStatus : std::uint8_t
+    {
+        Ok,
+        DivisionByZero  // The node or one of its operands divided by zero
+    };
+
+    /** Graph of every subexpression of every registered expression. */
+    ExpressionDag dag;
+
+    /** Cached value of each node, indexed by node id. */
+    std::vector<double> nodeValues;
+
+    /** Cached status of each node, indexed by node id. */
+    std::vector<NodeStatus> nodeStatuses;
+
+    /** Ids of the nodes that use each node as an operand, indexed by node id. */
+    std::vector<std::vector<std::size_t>> dependents;
+
+    /** Id of the variable node of each slot, or ExpressionDag::NO_NODE if no expression uses the variable. */
+    std::vector<std::size_t> variableNodes;
+
+    /** Current value of each variable slot. Unset variables are 0. */
+    std::vector<double> variableValues;
+
+    /** Root node of each registered expression, indexed by ExpressionId. */
+    std::vector<std::size_t> expressionRoots;
+
+    /** Generation of the last change that queued each node, indexed by node id. A node is queued for the current
+     * change if its stamp equals updateGeneration, so nothing has to be cleared between changes. */
+    std::vector<std::uint32_t> queuedGenerations;
+
+    /** Generation of the current change. Starts at 1, so new nodes with a stamp of 0 are not queued. */
+    std::uint32_t updateGeneration;
+
+    /** Min-heap of the node ids waiting to be recomputed, kept so its storage is reused by every change. */
+    std::vector<std::size_t> dirtyNodes;
+
+    /** Number of nodes computed by the last change. */
+    std::size_t lastUpdateCount;
+
+    /** Converter used by addExpression for infix text. */
+    InfixToPostfixEvaluation converter;
+
+    /** Computes the value of one node from the cached values of its operands.
+     * @pre The operands of the node have current values.
+     * @post The node value and status are stored.
+     * @param id The node to compute.
+     * @return True if the value or status of the node changed. */
+    bool computeNode(std::size_t id);
+
+    /** Records dependents and computes values of nodes added to the graph since it had firstNewNode nodes.
+     * @pre None
+     * @post Every node has a cached value and status.
+     * @param firstNewNode The number of nodes the graph had before the nodes were added. */
+    void registerNewNodes(std::size_t firstNewNode);
+
+    /** Converts a variable name to its slot in the symbol table of the converter.
+     * @pre None
+     * @post The symbol table holds the name.
+     * @param name The variable name, in either case.
+     * @return The variable slot.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    std::uint32_t slotOf(std::string_view name);
+
+public:
+    /** Default constructor. Creates an evaluator with no expressions and all variables set to 0. */
+    IncrementalEvaluator();
+
+    /** Creates an evaluator with no expressions and all variables set to 0.
+     * @pre None
+     * @post The evaluator is empty.
+     * @param options The simplification rules of the shared expression graph. */
+    explicit IncrementalEvaluator(ExpressionDag::Options options);
+
+    /** Gets the table that assigns slots to variable names for this evaluator.
+     * @pre None
+     * @post None
+     * @return The symbol table. */
+    std::shared_ptr<SymbolTable> getSymbolTable() const noexcept;
+
+    /** Registers a compiled program and computes its value.
+     * @pre The program only uses variables a-f or was compiled with getSymbolTable().
+     * @post The expression is kept up to date by later variable changes.
+     * @param program The program to register.
+     * @return The id of the expression.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered. */
+    ExpressionId addExpression(const PostfixProgram& program);
+
+    /** Converts an infix expression, registers it and computes its value.
+     * @pre None
+     * @post The expression is kept up to date by later variable changes.
+     * @param infixExpression The infix expression to register.
+     * @return The id of the expression.
+     * @throws std::runtime_error If the expression is not valid.
+     * @throws std::runtime_error If an unknown operator is encountered. */
+    ExpressionId addExpression(const std::string& infixExpression);
+
+    /** Gets the number of registered expressions.
+     * @pre None
+     * @post None
+     * @return The number of expressions. */
+    std::size_t getExpressionCount() const noexcept;
+
+    /** Changes the value of a variable and recomputes the subexpressions that depend on it.
+     * @pre None
+     * @post Every expression that uses the variable holds its new value.
+     * @param slot The variable slot. Only the nodes that depend on it are visited.
+     * @param value The new value. */
+    void setVariable(std::uint32_t slot, double value);
+
+    /** Changes the value of a variable and recomputes the subexpressions that depend on it.
+     * @pre None
+     * @post Every expression that uses the variable holds its new value.
+     * @param name The variable name, in either case.
+     * @param value The new value.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    void setVariable(const std::string& name, double value);
+
+    /** Changes the value of a single-letter variable and recomputes the subexpressions that depend on it.
+     * @pre None
+     * @post Every expression that uses the variable holds its new value.
+     * @param name A letter naming the variable, in either case.
+     * @param value The new value.
+     * @throws PrecondViolatedExcept If name is not a letter. */
+    void setVariable(char name, double value);
+
+    /** Gets the current value of a variable.
+     * @pre None
+     * @post None
+     * @param name The variable name, in either case.
+     * @return The value of the variable, or 0 if it was never set.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    double getVariable(const std::string& name) const;
+
+    /** Gets the current value of an expression without evaluating it.
+     * @pre None
+     * @post None
+     * @param expression The id returned by addExpression.
+     * @return The value of the expression for the current variable values.
+     * @throws PrecondViolatedExcept If the id does not name a registered expression.
+     * @throws std::runtime_error If division by zero occurs in the expression. */
+    double getValue(ExpressionId expression) const;
+
+    /** Gets the number of nodes computed by the last variable change, for monitoring.
+     * @pre None
+     * @post None
+     * @return The number of nodes computed. */
+    std::size_t getLastUpdateCount() const noexcept;
+}; // end IncrementalEvaluator
+
+#include "IncrementalEvaluator.cpp"
+#endif
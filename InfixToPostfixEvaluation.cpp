@@ -7,63 +7,101 @@
 #include "InfixToPostfixEvaluation.h"
 
 InfixToPostfixEvaluation::InfixToPostfixEvaluation()
+    : symbolTable(std::make_shared<SymbolTable>()), context(symbolTable),
+    compiledProgram(std::make_shared<const PostfixProgram>()), optimizationEnabled(true), backend(Backend::Stack)
 {} // end default constructor
 
 int InfixToPostfixEvaluation::precedence(char operatorChar) const noexcept
 {
-    if (operatorChar == '+' || operatorChar == '-')
-    {
-        return 1; // Operators '+' and '-' have a precedence of 1
-    }
-    if (operatorChar == '*' || operatorChar == '/')
-    {
-        return 2; // Operators '*' and '/' have a precedence of 2
-    }
-    return 0;
+    return PostfixProgram::precedence(operatorChar);  // Same rules as compile-time conversion
 } // end precedence
 
 void InfixToPostfixEvaluation::convertInfixToPostfix(const std::string& infixExpression) noexcept
 {
-    postfixExpQueue = OurQueue<char>();       // Initialize an empty queue
-    operatorStack = LinkedStack<char>();      // Initialize an empty stack
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Convert));
+    postfixExpQueue.clear();                  // Empty the queue, keeping its buffer
+    operatorStack.clear();                    // Empty the stack, keeping its storage
 
-    for (char currentChar : infixExpression) // Range based loop over infix expression
+    std::string cacheKey;
+    if (expressionCache)  // Reuse the program of an expression that was already converted
     {
-        currentChar = std::tolower(currentChar);  // Convert to lowercase if uppercase
-
-        if (std::isalpha(currentChar)) 
+        cacheKey = CompiledExpressionCache::normalize(infixExpression);
+        std::shared_ptr<const PostfixProgram> cachedProgram = expressionCache->find(cacheKey, symbolTable.get());
+        if (cachedProgram)
         {
-            postfixExpQueue.enqueue(currentChar);  // Enqueue operand to postfix expression
+            compiledProgram = std::move(cachedProgram);
+            lowerCompiledProgram();
+            return;
         }
-        else 
+    }
+
+    // Every token is followed by a space in the queue. Spaces are only kept in the postfix text if a token is
+    // longer than one character, so expressions of single letters keep their compact form, such as "ab+c*".
+    // Compact text without an operator is read back as a single token, so several operands with no operator,
+    // as in "a b", are spaced too instead of merging into the name "ab".
+    bool spaced = false;
+    std::size_t operandCount = 0;
+    bool hasOperator = false;
+    bool balanced = true;  // Cleared by a closing parenthesis with no opening one
+    ExpressionTokenizer tokenizer(infixExpression);
+    ExpressionTokenizer::Token token;
+
+    while (tokenizer.next(token))
+    {
+        char currentChar = token.text[0];
+
+        switch (token.kind)
         {
-            switch (currentChar) 
+        case ExpressionTokenizer::TokenKind::Identifier:
+        case ExpressionTokenizer::TokenKind::Number:
+            for (char operandChar : token.text)
+            {
+                postfixExpQueue.enqueue(static_cast<char>(std::tolower(static_cast<unsigned char>(operandChar))));  // Enqueue operand in lowercase
+            }
+            postfixExpQueue.enqueue(' ');
+            if (token.text.size() > 1) spaced = true;
+            ++operandCount;
+            break;
+
+        case ExpressionTokenizer::TokenKind::LeftParenthesis:  // Opening parenthesis
+            operatorStack.push(currentChar);  // Save '(' on stack
+            POSTFIX_STATS(PostfixStatistics::recordOperatorStackDepth(operatorStack.size()));
+            break;
+
+        case ExpressionTokenizer::TokenKind::Operator:  // Valid operators
+            hasOperator = true;
+            while (!operatorStack.isEmpty() && operatorStack.peek() != '(' &&
+                precedence(currentChar) <= precedence(operatorStack.peek())) 
+            {
+                char nextOperator = operatorStack.peek();
+                postfixExpQueue.enqueue(nextOperator);  // Enqueue operator
+                postfixExpQueue.enqueue(' ');
+                operatorStack.pop();
+            }
+            operatorStack.push(currentChar);  // Save the operator on stack
+            POSTFIX_STATS(PostfixStatistics::recordOperatorStackDepth(operatorStack.size()));
+            break;
+
+        case ExpressionTokenizer::TokenKind::RightParenthesis:  // Closing parenthesis
+            while (!operatorStack.isEmpty() && operatorStack.peek() != '(') 
+            {
+                char nextOperator = operatorStack.peek();
+                postfixExpQueue.enqueue(nextOperator);  // Enqueue operator
+                postfixExpQueue.enqueue(' ');
+                operatorStack.pop();
+            }
+            if (operatorStack.isEmpty())
+            {
+                balanced = false;  // Unmatched, so the expression is invalid
+            }
+            else
             {
-            case '(':  // Opening parenthesis
-                operatorStack.push(currentChar);  // Save '(' on stack
-                break;
-
-            case '+': case '-': case '*': case '/':  // Valid operators
-                while (!operatorStack.isEmpty() && operatorStack.peek() != '(' &&
-                    precedence(currentChar) <= precedence(operatorStack.peek())) 
-                {
-                    char nextOperator = operatorStack.peek();
-                    postfixExpQueue.enqueue(nextOperator);  // Enqueue operator
-                    operatorStack.pop();
-                }
-                operatorStack.push(currentChar);  // Save the operator on stack
-                break;
-
-            case ')':  // Closing parenthesis
-                while (operatorStack.peek() != '(') 
-                {
-                    char nextOperator = operatorStack.peek();
-                    postfixExpQueue.enqueue(nextOperator);  // Enqueue operator
-                    operatorStack.pop();
-                }
                 operatorStack.pop();  // Remove the open parenthesis
-                break;
             }
+            break;
+
+        case ExpressionTokenizer::TokenKind::Invalid:  // Other characters are ignored
+            break;
         }
     }
 
@@ -72,25 +110,127 @@ void InfixToPostfixEvaluation::convertInfixToPostfix(const std::string& infixExp
     {
         char nextOperator = operatorStack.peek();
         postfixExpQueue.enqueue(nextOperator);  // Enqueue remaining operators
+        postfixExpQueue.enqueue(' ');
         operatorStack.pop();
     }
-} // end convertInfixToPostfix
 
-std::string InfixToPostfixEvaluation::getPostfixExpression() const noexcept 
-{
-    // Convert the contents of postfixExpQueue to a string for output
-    OurQueue<char> tempQueue = postfixExpQueue;  // Copy the queue to avoid modifying the original
+    if (operandCount > 1 && !hasOperator) spaced = true;
+
+    // Read the queue in place to build the postfix text once, then compile it so it can be evaluated many times
     std::string postfixExpression;
+    postfixExpression.reserve(postfixExpQueue.size());
+    for (char postfixChar : postfixExpQueue)
+    {
+        if (postfixChar != ' ' || spaced) postfixExpression += postfixChar;
+    }
+    if (!postfixExpression.empty() && postfixExpression.back() == ' ') postfixExpression.pop_back();
+
+    if (!balanced)
+    {
+        // Keep the postfix text for reporting, but compile no instructions so every evaluation reports an
+        // invalid expression
+        compiledProgram = std::make_shared<const PostfixProgram>(std::vector<PostfixProgram::Instruction>(),
+            std::vector<double>(), 0, std::move(postfixExpression), symbolTable);
+    }
+    else
+    {
+        compiledProgram = std::make_shared<const PostfixProgram>(std::move(postfixExpression), symbolTable);
+    }
+    if (optimizationEnabled && balanced)
+    {
+        try
+        {
+            compiledProgram = PostfixOptimizer().optimize(compiledProgram);  // Shorter program, same results
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Keep the unoptimized program
+        }
+    }
+
+    if (expressionCache)
+    {
+        expressionCache->insert(cacheKey, compiledProgram);
+    }
+    lowerCompiledProgram();
+} // end convertInfixToPostfix
 
-    while (!tempQueue.isEmpty()) 
+void InfixToPostfixEvaluation::lowerCompiledProgram() noexcept
+{
+    registerProgram.reset();
+    if (backend != Backend::Register) return;
+    try
+    {
+        registerProgram = std::make_shared<const RegisterProgram>(compiledProgram->getView());
+    }
+    catch (const std::bad_alloc&)
     {
-        postfixExpression += tempQueue.peekFront();
-        tempQueue.dequeue();
+        // Evaluate with the stack backend instead
     }
+} // end lowerCompiledProgram
 
-    return postfixExpression;
+std::shared_ptr<const PostfixProgram> InfixToPostfixEvaluation::getCompiledProgram() const noexcept
+{
+    return compiledProgram;
+} // end getCompiledProgram
+
+void InfixToPostfixEvaluation::setExpressionCache(std::shared_ptr<CompiledExpressionCache> cache) noexcept
+{
+    expressionCache = std::move(cache);
+} // end setExpressionCache
+
+void InfixToPostfixEvaluation::setOptimizationEnabled(bool enabled) noexcept
+{
+    optimizationEnabled = enabled;
+} // end setOptimizationEnabled
+
+void InfixToPostfixEvaluation::setBackend(Backend selected) noexcept
+{
+    backend = selected;
+    lowerCompiledProgram();
+} // end setBackend
+
+std::shared_ptr<const RegisterProgram> InfixToPostfixEvaluation::getRegisterProgram() const noexcept
+{
+    return registerProgram;
+} // end getRegisterProgram
+
+std::string InfixToPostfixEvaluation::getPostfixExpression() const noexcept 
+{
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Stringify));
+    return std::string(getPostfixExpressionView());  // The compiled program already holds the postfix text
 } // end getPostfixExpression
 
+std::string_view InfixToPostfixEvaluation::getPostfixExpressionView() const noexcept
+{
+    return compiledProgram->getPostfixText();
+} // end getPostfixExpressionView
+
+std::shared_ptr<SymbolTable> InfixToPostfixEvaluation::getSymbolTable() const noexcept
+{
+    return symbolTable;
+} // end getSymbolTable
+
+EvaluationContext InfixToPostfixEvaluation::createEvaluationContext() const
+{
+    return EvaluationContext(symbolTable);
+} // end createEvaluationContext
+
+const EvaluationContext& InfixToPostfixEvaluation::getEvaluationContext() const noexcept
+{
+    return context;
+} // end getEvaluationContext
+
+void InfixToPostfixEvaluation::setVariable(const std::string& name, double value)
+{
+    context.setVariable(name, value);
+} // end setVariable
+
+double InfixToPostfixEvaluation::getVariable(const std::string& name) const
+{
+    return context.getVariable(name);
+} // end getVariable
+
 void InfixToPostfixEvaluation::readValuesFromFile(const std::string& filename)
 {
     std::ifstream file(filename); // Open the file
@@ -101,87 +241,76 @@ void InfixToPostfixEvaluation::readValuesFromFile(const std::string& filename)
 
     for (size_t i = 0; i < CAPACITY; ++i) // Add values from the file into array
     {
-        if (!(file >> variableValues[i])) 
+        double value = 0;
+        if (!(file >> value)) 
         {
             throw std::runtime_error("File does not contain enough values."); // Throw error if there are not enough values
         }
+        context.setVariable(static_cast<std::uint32_t>(i), value);
     }
 } // end readValuesFromFile
 
 void InfixToPostfixEvaluation::clearVariableValues() noexcept
 {
-    for (size_t i = 0; i < CAPACITY; ++i) // Set values to zero to clear the array
-    {
-        variableValues[i] = 0;
-    }
+    context.clear(); // Set values to zero to clear the array
 } // end clearVariableValues
 
 std::string InfixToPostfixEvaluation::getVariableValues() const noexcept
 {
-    std::string result = "Variable values : "; // Delare string to concatenate values
-    for (size_t i = 0; i < CAPACITY; ++i) 
+    std::ostringstream result;
+    result << "Variable values : "; // Delare string to concatenate values
+    const double* values = context.getValues();
+    for (size_t i = 0; i < context.getValueCount(); ++i) 
     {
-        result += " " + std::to_string(variableValues[i]); // Concatenate all values from the array to the string
+        if (i < CAPACITY)
+        {
+            result << " " << values[i]; // Concatenate all values from the array to the string
+        }
+        else if (context.isAssigned(static_cast<std::uint32_t>(i)))
+        {
+            result << " " << symbolTable->getName(static_cast<std::uint32_t>(i)) << "=" << values[i]; // Named variables
+        }
     }
-    return result; // Return string of values
+    return result.str(); // Return string of values
 } // end getVariableValues
 
 double InfixToPostfixEvaluation::evaluatePostfixExpression() 
 {
-    LinkedStack<double> evaluationStack;  // Stack to hold intermediate results
+    return evaluatePostfixExpression(context);
+} // end evaluatePostfixExpression
 
-    // Loop through each character in the postfix expression queue
-    while (!postfixExpQueue.isEmpty()) 
+double InfixToPostfixEvaluation::evaluatePostfixExpression(EvaluationContext& evaluationContext) const
+{
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Evaluate));
+    return PostfixStatistics::countExceptions([&]()
     {
-        char currentChar = postfixExpQueue.peekFront();
-        postfixExpQueue.dequeue();
-
-        if (std::isalpha(currentChar))  // Operand
-        {
-            int variableIndex = currentChar - 'a';  // Convert variables to corresponding index
-            evaluationStack.push(variableValues[variableIndex]);
-        }
-        else  // Operator
-        {
-            if (evaluationStack.isEmpty()) throw std::runtime_error("Invalid postfix expression");
-
-            // Pop the top two operands
-            double operand2 = evaluationStack.peek();
-            evaluationStack.pop();
-
-            if (evaluationStack.isEmpty()) throw std::runtime_error("Invalid postfix expression");
-            double operand1 = evaluationStack.peek();
-            evaluationStack.pop();
-
-            double result = 0;
-
-            // Perform the operation based on the operator
-            switch (currentChar) 
-            {
-            case '+': result = operand1 + operand2; break;
-            case '-': result = operand1 - operand2; break;
-            case '*': result = operand1 * operand2; break;
-            case '/':
-                if (operand2 == 0) throw std::runtime_error("Division by zero");
-                result = operand1 / operand2;
-                break;
-            default:
-                throw std::runtime_error("Unknown operator encountered");
-            }
-
-            // Push the result back onto the stack
-            evaluationStack.push(result);
-        }
-    }
+        if (registerProgram) return evaluationContext.evaluate(*registerProgram);
+        return evaluationContext.evaluate(*compiledProgram);  // Evaluate without consuming the postfix expression
+    });
+} // end evaluatePostfixExpression
 
-    // The final result should be the only element in the stack
-    if (evaluationStack.isEmpty()) throw std::runtime_error("Invalid postfix expression");
+std::vector<double> InfixToPostfixEvaluation::evaluatePostfixExpressionBatch(const VariableColumns& columns) const
+{
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Evaluate));
+    std::vector<double> results(columns.getRowCount());
+    PostfixStatistics::countExceptions([&]() { compiledProgram->evaluateBatch(columns, results.data()); });
+    return results;
+} // end evaluatePostfixExpressionBatch
 
-    double finalResult = evaluationStack.peek();
-    evaluationStack.pop();
+EvaluationResult InfixToPostfixEvaluation::tryEvaluatePostfixExpression()
+{
+    return tryEvaluatePostfixExpression(context);
+} // end tryEvaluatePostfixExpression
 
-    // If the stack is not empty, it means the postfix expression was invalid
-    if (!evaluationStack.isEmpty()) throw std::runtime_error("Invalid postfix expression");
+EvaluationResult InfixToPostfixEvaluation::tryEvaluatePostfixExpression(EvaluationContext& evaluationContext) const
+{
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Evaluate));
+    if (registerProgram) return evaluationContext.tryEvaluate(*registerProgram);
+    return evaluationContext.tryEvaluate(*compiledProgram);
+} // end tryEvaluatePostfixExpression
 
-    return finalResult;
-} // end evaluatePostfixExpression
+BatchEvaluationResult InfixToPostfixEvaluation::tryEvaluatePostfixExpressionBatch(const VariableColumns& columns) const
+{
+    POSTFIX_STATS(PostfixStatistics::PhaseTimer timer(PostfixStatistics::Phase::Evaluate));
+    return compiledProgram->tryEvaluateBatch(columns);
+} // end tryEvaluatePostfixExpressionBatch
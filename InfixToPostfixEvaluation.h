@@ -6,27 +6,72 @@
 #define INFIX_TO_POSTFIX_EVALUATION_
 
 #include <string>
+#include <string_view>
 #include <cctype>
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
+#include <memory>
+#include <vector>
 #include "InfixToPostfixInterface.h"
-#include "OurQueue.h"
-#include "LinkedStack.h"
+#include "RingQueue.h"
+#include "ArrayStack.h"
+#include "PostfixProgram.h"
+#include "VariableColumns.h"
+#include "CompiledExpressionCache.h"
+#include "PostfixOptimizer.h"
+#include "PostfixStatistics.h"
+#include "SymbolTable.h"
+#include "ExpressionTokenizer.h"
+#include "EvaluationContext.h"
+#include "RegisterProgram.h"
 
 class InfixToPostfixEvaluation : public InfixToPostfixInterface
 {
+public:
+    /** Interpreters that can evaluate converted expressions. */
+    enum class Backend
+    {
+        Stack,    // PostfixProgramView runs the postfix instructions on an operand stack
+        Register  // RegisterProgram runs three-address instructions lowered from them
+    };
+
 private:
-    /** Capacity of the variable values array */
-    static constexpr size_t CAPACITY = 6;
+    /** Number of predefined variables a-f, which always have values */
+    static constexpr size_t CAPACITY = SymbolTable::PREDEFINED_COUNT;
+
+    /** Queue to store the postfix expression. A ring buffer that is reused between conversions. */
+    RingQueue<char> postfixExpQueue;
+
+    /** Stack to manage operators during conversion. Contiguous storage avoids an allocation per push. */
+    ArrayStack<char> operatorStack;
+
+    /** Table that assigns slots to variable names. */
+    std::shared_ptr<SymbolTable> symbolTable;
+
+    /** Variable values and evaluation storage used by evaluatePostfixExpression(). */
+    EvaluationContext context;
+
+    /** Compiled form of the last converted expression, shared so it can be evaluated many times. */
+    std::shared_ptr<const PostfixProgram> compiledProgram;
 
-    /** Queue to store the postfix expression */
-    OurQueue<char> postfixExpQueue;
+    /** Optional cache of compiled programs shared with other evaluators. */
+    std::shared_ptr<CompiledExpressionCache> expressionCache;
 
-    /** Stack to manage operators during conversion */
-    LinkedStack<char> operatorStack;
+    /** True if converted programs are passed through PostfixOptimizer before they are used. */
+    bool optimizationEnabled;
 
-    /** Array to store values of variables a-f. All values are initially set to 0. */
-    int variableValues[CAPACITY];
+    /** The interpreter used by evaluatePostfixExpression(). */
+    Backend backend;
+
+    /** The compiled program lowered to registers when the register backend is selected, otherwise nullptr. */
+    std::shared_ptr<const RegisterProgram> registerProgram;
+
+    /** Lowers the compiled program to registers if the register backend is selected.
+     * @pre None
+     * @post registerProgram matches compiledProgram, or is nullptr if the stack backend is selected or lowering
+     * ran out of memory, in which case the stack backend is used. */
+    void lowerCompiledProgram() noexcept;
 
     /** Helper function to determine the precedence of an operator.
      * @pre None
@@ -42,18 +87,101 @@ public:
     /** Virtual destructor */
     virtual ~InfixToPostfixEvaluation() = default;
 
-    /** Converts an infix expression to a postfix expression.
-     * @pre Assumes infix expression is valid.
-     * @post Infix expression is converted to postfix. Infix expression is unchanged.
+    /** Converts an infix expression to a postfix expression and compiles it into a PostfixProgram, which is then
+     * optimized unless optimization is turned off. Operands are variable names of any length and integer or
+     * floating-point literals. Names are case-insensitive. If any operand is longer than one character, or
+     * there are several operands and no operator, the tokens of the postfix expression are separated by spaces. When an expression cache is set, a cached program for the same
+     * normalized text is reused without parsing. An expression with a closing parenthesis that has no opening one
+     * compiles to a program that every evaluation reports as an invalid postfix expression.
+     * @pre None
+     * @post Infix expression is converted to postfix and compiled. Infix expression is unchanged.
      * @param infixExpression The infix expression to convert. */
     void convertInfixToPostfix(const std::string& infixExpression) noexcept override;
 
+    /** Retrieves the compiled program of the last converted expression.
+     * @pre None
+     * @post None
+     * @return A shared pointer to the immutable compiled program. It stays valid after later conversions. */
+    std::shared_ptr<const PostfixProgram> getCompiledProgram() const noexcept;
+
+    /** Sets the cache of compiled programs used by convertInfixToPostfix. The cache can be shared by many
+     * evaluators, including evaluators on other threads.
+     * @pre None
+     * @post Later conversions look up and fill the cache.
+     * @param cache The cache to use, or nullptr to convert every expression from scratch. */
+    void setExpressionCache(std::shared_ptr<CompiledExpressionCache> cache) noexcept;
+
+    /** Turns optimization of converted programs on or off. Optimization is on by default. Programs found in an
+     * expression cache are used as they were stored.
+     * @pre None
+     * @post Later conversions are optimized if enabled is true.
+     * @param enabled True to optimize converted programs, false to run them exactly as converted. */
+    void setOptimizationEnabled(bool enabled) noexcept;
+
+    /** Selects the interpreter used by evaluatePostfixExpression(). The stack backend is the default. With the
+     * register backend every converted program is also lowered to a RegisterProgram. Results and errors are the
+     * same for both; batch evaluation always uses the block interpreter of PostfixProgramView.
+     * @pre None
+     * @post The current and later programs are evaluated with the given backend.
+     * @param selected The backend to use. */
+    void setBackend(Backend selected) noexcept;
+
+    /** Retrieves the register form of the last converted expression.
+     * @pre None
+     * @post None
+     * @return The lowered program, or nullptr unless the register backend is selected. */
+    std::shared_ptr<const RegisterProgram> getRegisterProgram() const noexcept;
+
     /** Retrieves the converted postfix expression.
      * @pre None
      * @post None
      * @return A string representing the postfix expression. */
     std::string getPostfixExpression() const noexcept override;
 
+    /** Retrieves the converted postfix expression without copying it.
+     * @pre None
+     * @post None
+     * @return A view of the postfix expression. It stays valid until the next conversion, or for as long as the
+     * compiled program from getCompiledProgram() is held. */
+    std::string_view getPostfixExpressionView() const noexcept;
+
+    /** Gets the table that assigns slots to variable names. Other evaluators can share compiled programs of this
+     * evaluator if they use the same table.
+     * @pre None
+     * @post None
+     * @return The symbol table. */
+    std::shared_ptr<SymbolTable> getSymbolTable() const noexcept;
+
+    /** Creates an evaluation context that shares the symbol table of this evaluator, so another thread can
+     * evaluate the programs compiled here with its own variable values and without locks.
+     * @pre None
+     * @post None
+     * @return A new context in which a-f are 0 and no named variable has a value. */
+    EvaluationContext createEvaluationContext() const;
+
+    /** Gets the variable values used by evaluatePostfixExpression(). A copy evaluates with the same values on
+     * another thread.
+     * @pre None
+     * @post None
+     * @return The evaluation context of this evaluator. */
+    const EvaluationContext& getEvaluationContext() const noexcept;
+
+    /** Sets the value of a variable, adding the name to the symbol table if it is new.
+     * @pre None
+     * @post The variable has the value.
+     * @param name The variable name: a letter followed by letters, digits or underscores.
+     * @param value The new value.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    void setVariable(const std::string& name, double value);
+
+    /** Gets the value of a variable.
+     * @pre None
+     * @post None
+     * @param name The variable name.
+     * @return The value of the variable.
+     * @throws std::runtime_error If the variable has no value. */
+    double getVariable(const std::string& name) const;
+
     /** Reads variable values from a specified file and stores them in the variableValues array.
      * @pre Assumes file exists and contains at least the same number of integer values as CAPACITY
      * @post variableValues it filled with integer values from file. File is unchanged.
@@ -74,14 +202,62 @@ public:
     std::string getVariableValues() const noexcept override;
 
     /**
-     * Evaluates the current postfix expression stored in `postfixExpQueue`.
-     * @pre `postfixExpQueue` contains a valid postfix expression.
-     * @post Returns the evaluated result of the postfix expression.
+     * Evaluates the compiled program of the current postfix expression.
+     * @pre The compiled program holds a valid postfix expression.
+     * @post Returns the evaluated result of the postfix expression. The expression can be evaluated again.
      * @return The integer result of the postfix expression evaluation.
+     * @throws std::runtime_error If a variable in the expression has no value.
      * @throws std::runtime_error If the postfix expression is invalid.
      * @throws std::runtime_error If an unknown operator is encountered.
      * @throws std::runtime_error If division by zero occurs. */
     double evaluatePostfixExpression() override;
+
+    /** Evaluates the compiled program of the current postfix expression against the values of a caller-owned
+     * context. The evaluator is not changed, so threads that each own a context can call this concurrently.
+     * @pre The compiled program holds a valid postfix expression. No conversion runs at the same time.
+     * @post Does not change the postfix expression or the variable values of the evaluator.
+     * @param evaluationContext The context holding the variable values and evaluation storage.
+     * @return The result of the postfix expression evaluation.
+     * @throws std::runtime_error If a variable in the expression has no value.
+     * @throws std::runtime_error If the postfix expression is invalid.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluatePostfixExpression(EvaluationContext& evaluationContext) const;
+
+    /** Evaluates the compiled program of the current postfix expression over many rows of variable values.
+     * @pre The compiled program holds a valid postfix expression.
+     * @post Does not change the postfix expression or the variable values.
+     * @param columns The variable values, one contiguous column per variable.
+     * @return One result per row of columns.
+     * @throws std::runtime_error If the postfix expression is invalid.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs in any row. */
+    std::vector<double> evaluatePostfixExpressionBatch(const VariableColumns& columns) const;
+
+    /** Evaluates the compiled program of the current postfix expression without throwing. Uses the variable
+     * values and evaluation storage of the evaluator's own context, so it must not run concurrently with another
+     * evaluation by this evaluator.
+     * @pre None
+     * @post Does not change the postfix expression or the variable values. The evaluation storage may grow.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluatePostfixExpression();
+
+    /** Evaluates the compiled program of the current postfix expression against the values of a caller-owned
+     * context without throwing. The evaluator is not changed, so threads that each own a context can call this
+     * concurrently.
+     * @pre No conversion runs at the same time.
+     * @post Does not change the postfix expression or the variable values of the evaluator.
+     * @param evaluationContext The context holding the variable values and evaluation storage.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluatePostfixExpression(EvaluationContext& evaluationContext) const;
+
+    /** Evaluates the compiled program of the current postfix expression over many rows of variable values without
+     * throwing. Rows that divide by zero are marked in the error bitmap of the result instead of stopping the batch.
+     * @pre None
+     * @post Does not change the postfix expression or the variable values.
+     * @param columns The variable values, one contiguous column per variable.
+     * @return The results and error bitmap, or the status of an expression that cannot be evaluated at all. */
+    BatchEvaluationResult tryEvaluatePostfixExpressionBatch(const VariableColumns& columns) const;
 };
 
 #include "InfixToPostfixEvaluation.cpp"
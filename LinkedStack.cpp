@@ -8,13 +8,19 @@
 #include "PrecondViolatedExcept.h"
 
 // Default constructor initializes the stack as empty by setting the top pointer to nullptr.
-template<class ItemType>
-LinkedStack<ItemType>::LinkedStack() : topPtr(nullptr)
+template<class ItemType, class Allocator>
+LinkedStack<ItemType, Allocator>::LinkedStack() : topPtr(nullptr)
 {} // end default constructor
 
+// Constructor initializes the stack as empty and keeps the allocator for its nodes.
+template<class ItemType, class Allocator>
+LinkedStack<ItemType, Allocator>::LinkedStack(const Allocator& allocator) : topPtr(nullptr), nodeAllocator(allocator)
+{} // end allocator constructor
+
 // Copy constructor that creates a deep copy of the original stack.
-template<class ItemType>
-LinkedStack<ItemType>::LinkedStack(const LinkedStack<ItemType>& originalStack)
+template<class ItemType, class Allocator>
+LinkedStack<ItemType, Allocator>::LinkedStack(const LinkedStack<ItemType, Allocator>& originalStack)
+    : nodeAllocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(originalStack.nodeAllocator))
 {
     // Initialize a pointer to traverse the original stack
     auto originalChainPtr = originalStack.topPtr;
@@ -23,8 +29,9 @@ LinkedStack<ItemType>::LinkedStack(const LinkedStack<ItemType>& originalStack)
     else
     {
         // Copy the first node of the original stack
-        topPtr = std::make_shared<Node<ItemType>>();
+        topPtr = std::allocate_shared<Node<ItemType>>(nodeAllocator);
         topPtr->setItem(originalChainPtr->getItem());
+        POSTFIX_STATS(PostfixStatistics::recordNodeAllocation());
 
         // Create a pointer to track the end of the new chain
         auto myChainTailPtr = topPtr;
@@ -37,7 +44,8 @@ LinkedStack<ItemType>::LinkedStack(const LinkedStack<ItemType>& originalStack)
         {
             // Copy the next item from the original stack
             auto nextItem = originalChainPtr->getItem();
-            auto itemNodePtr = std::make_shared<Node<ItemType>>(nextItem);
+            auto itemNodePtr = std::allocate_shared<Node<ItemType>>(nodeAllocator, nextItem);
+            POSTFIX_STATS(PostfixStatistics::recordNodeAllocation());
 
             // Link the new node to the end of the new chain
             myChainTailPtr->setNext(itemNodePtr);
@@ -52,25 +60,26 @@ LinkedStack<ItemType>::LinkedStack(const LinkedStack<ItemType>& originalStack)
 } // end copy constructor
 
 // Destructor that clears all nodes from the stack.
-template<class ItemType>
-LinkedStack<ItemType>::~LinkedStack()
+template<class ItemType, class Allocator>
+LinkedStack<ItemType, Allocator>::~LinkedStack()
 {
     clear();  // Clear the stack by setting topPtr to nullptr
 } // end destructor
 
 // Checks if the stack is empty.
-template<class ItemType>
-bool LinkedStack<ItemType>::isEmpty() const noexcept
+template<class ItemType, class Allocator>
+bool LinkedStack<ItemType, Allocator>::isEmpty() const noexcept
 {
     return topPtr == nullptr;
 }  // end isEmpty
 
 // Pushes an item onto the top of the stack.
-template<class ItemType>
-bool LinkedStack<ItemType>::push(const ItemType& someItem) noexcept
+template<class ItemType, class Allocator>
+bool LinkedStack<ItemType, Allocator>::push(const ItemType& someItem) noexcept
 {
     // Create a new node pointing to the current top of the stack
-    auto itemNodePtr = std::make_shared<Node<ItemType>>(someItem, topPtr);
+    auto itemNodePtr = std::allocate_shared<Node<ItemType>>(nodeAllocator, someItem, topPtr);
+    POSTFIX_STATS(PostfixStatistics::recordNodeAllocation());
 
     // Update the top pointer to the new node
     topPtr = itemNodePtr;
@@ -78,8 +87,8 @@ bool LinkedStack<ItemType>::push(const ItemType& someItem) noexcept
 }  // end push
 
 // Pops (removes) the item at the top of the stack.
-template<class ItemType>
-bool LinkedStack<ItemType>::pop() noexcept
+template<class ItemType, class Allocator>
+bool LinkedStack<ItemType, Allocator>::pop() noexcept
 {
     if (!isEmpty())
     {
@@ -98,8 +107,8 @@ bool LinkedStack<ItemType>::pop() noexcept
 }  // end pop
 
 // Retrieves the item at the top of the stack without removing it.
-template<class ItemType>
-ItemType LinkedStack<ItemType>::peek() const
+template<class ItemType, class Allocator>
+ItemType LinkedStack<ItemType, Allocator>::peek() const
 {
     // Check if the stack is empty before peeking
     if (isEmpty())
@@ -109,8 +118,15 @@ ItemType LinkedStack<ItemType>::peek() const
 }  // end peek
 
 // Clears all items from the stack.
-template<class ItemType>
-void LinkedStack<ItemType>::clear()
+template<class ItemType, class Allocator>
+void LinkedStack<ItemType, Allocator>::clear()
 {
     topPtr = nullptr;  // Automatically deallocates all nodes in the stack
-} // end clear
\ No newline at end of file
+} // end clear
+
+// Gets the allocator used for the nodes.
+template<class ItemType, class Allocator>
+Allocator LinkedStack<ItemType, Allocator>::getAllocator() const noexcept
+{
+    return nodeAllocator;
+} // end getAllocator
\ No newline at end of file
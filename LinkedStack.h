@@ -1,30 +1,43 @@
 /** @file LinkedStack.h
  * @class LinkedStack
- * Implements a stack using a linked list of nodes with smart pointers and inherits from StackInterface. */
+ * Implements a stack using a linked list of nodes with smart pointers and inherits from StackInterface.
+ * Nodes are allocated through Allocator, so a stack can draw its nodes from a pool or a per-request arena such as a
+ * std::pmr::monotonic_buffer_resource and release them all at once. */
 
 #ifndef LINKED_STACK_
 #define LINKED_STACK_
 
 #include "StackInterface.h"
 #include "Node.h"
+#include "PostfixStatistics.h"
 #include <memory>
+#include <memory_resource>
 
-template<class ItemType>
+template<class ItemType, class Allocator = std::allocator<ItemType>>
 class LinkedStack : public StackInterface<ItemType>
 {
 private:
     /** Pointer to the top node in the stack */
     std::shared_ptr<Node<ItemType>> topPtr;
 
+    /** Allocator used for every node and its reference count. */
+    Allocator nodeAllocator;
+
 public:
     /** Default constructor
      * Initializes the stack to be empty. */
     LinkedStack();
 
+    /** Constructor
+     * Initializes the stack to be empty and to allocate its nodes with a given allocator.
+     * @param allocator The allocator for the nodes, for example a std::pmr::polymorphic_allocator over an arena.
+     * The memory it draws from must outlive the stack. */
+    explicit LinkedStack(const Allocator& allocator);
+
     /** Copy constructor
      * Creates a copy of another LinkedStack.
      * @param originalStack The stack to be copied. */
-    LinkedStack(const LinkedStack<ItemType>& originalStack);
+    LinkedStack(const LinkedStack<ItemType, Allocator>& originalStack);
 
     /** Destructor
      * Frees the dynamically allocated memory. */
@@ -61,7 +74,17 @@ public:
      * @post The stack is empty. */
     void clear() final override;
 
+    /** Gets the allocator used for the nodes.
+     * @pre None
+     * @post None
+     * @return A copy of the node allocator. */
+    Allocator getAllocator() const noexcept;
+
 };
 
+/** A LinkedStack whose nodes are allocated from a std::pmr::memory_resource. */
+template<class ItemType>
+using PmrLinkedStack = LinkedStack<ItemType, std::pmr::polymorphic_allocator<ItemType>>;
+
 #include "LinkedStack.cpp"
 #endif
@@ -0,0 +1,135 @@
+/** @file LockFreeQueue.cpp
+ * LockFreeQueue implements a bounded multi-producer, multi-consumer queue with a ring of sequenced cells.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "LockFreeQueue.h"
+
+// Constructor that rounds the capacity up to a power of two and marks every cell free for its first enqueue.
+template<class ItemType>
+LockFreeQueue<ItemType>::LockFreeQueue(std::size_t capacity)
+    : enqueuePosition(0), dequeuePosition(0)
+{
+    std::size_t cellCount = 2;
+    while (cellCount < capacity)
+    {
+        cellCount *= 2;
+    }
+    cells.reset(new Cell[cellCount]);
+    mask = cellCount - 1;
+    for (std::size_t i = 0; i < cellCount; ++i)
+    {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+} // end constructor
+
+template<class ItemType>
+bool LockFreeQueue<ItemType>::isEmpty() const noexcept
+{
+    return size() == 0;
+} // end isEmpty
+
+// Claims the cell at the enqueue position once the consumer of the previous lap has emptied it.
+template<class ItemType>
+bool LockFreeQueue<ItemType>::enqueue(const ItemType& someItem)
+{
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells[position & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0)  // Cell is free for this position, try to claim it
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.item = someItem;
+                cell.sequence.store(position + 1, std::memory_order_release);  // Publish the item to consumers
+                return true;
+            }
+        }
+        else if (difference < 0)  // Cell still holds the item of the previous lap, so the queue is full
+        {
+            return false;
+        }
+        else  // Another producer claimed this position first
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+} // end enqueue
+
+// Claims the cell at the dequeue position once its producer has published an item, then frees it for the next lap.
+template<class ItemType>
+bool LockFreeQueue<ItemType>::tryDequeue(ItemType& item)
+{
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells[position & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+        if (difference == 0)  // Cell holds the item for this position, try to claim it
+        {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                item = std::move(cell.item);
+                cell.sequence.store(position + mask + 1, std::memory_order_release);  // Free the cell for the next lap
+                return true;
+            }
+        }
+        else if (difference < 0)  // No item has been published at this position, so the queue is empty
+        {
+            return false;
+        }
+        else  // Another consumer claimed this position first
+        {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+} // end tryDequeue
+
+template<class ItemType>
+bool LockFreeQueue<ItemType>::dequeue()
+{
+    ItemType discarded;
+    return tryDequeue(discarded);
+} // end dequeue
+
+template<class ItemType>
+ItemType LockFreeQueue<ItemType>::peekFront() const
+{
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    const Cell& cell = cells[position & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        throw PrecondViolatedExcept("peekFront() called with an empty queue.");
+    }
+    return cell.item;
+} // end peekFront
+
+template<class ItemType>
+void LockFreeQueue<ItemType>::clear()
+{
+    while (dequeue())
+    {
+    }
+} // end clear
+
+template<class ItemType>
+std::size_t LockFreeQueue<ItemType>::size() const noexcept
+{
+    // Read the consumer position first so a concurrent dequeue cannot make the count negative
+    std::size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+    std::size_t enqueued = enqueuePosition.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+} // end size
+
+template<class ItemType>
+std::size_t LockFreeQueue<ItemType>::getCapacity() const noexcept
+{
+    return mask + 1;
+} // end getCapacity
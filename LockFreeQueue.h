@@ -0,0 +1,118 @@
+/** @file LockFreeQueue.h
+ * @class LockFreeQueue
+ * Implements a bounded multi-producer, multi-consumer queue without locks and inherits from QueueInterface. Items
+ * live in a fixed ring of cells, each with a sequence number that tells producers and consumers whether the cell is
+ * free or filled for their turn, so threads only contend on one atomic position each (Vyukov's bounded queue).
+ * enqueue fails instead of waiting when the queue is full. Threads that share the queue should take items with
+ * tryDequeue, since peekFront followed by dequeue can remove an item another thread peeked. */
+
+#ifndef LOCK_FREE_QUEUE_
+#define LOCK_FREE_QUEUE_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "QueueInterface.h"
+#include "PrecondViolatedExcept.h"
+
+template<class ItemType>
+class LockFreeQueue : public QueueInterface<ItemType>
+{
+public:
+    /** Capacity of a queue created without one. */
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+private:
+    /** Size of a cache line, so the positions written by producers and by consumers do not share one. */
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /** One slot of the ring. */
+    struct Cell
+    {
+        /** Position of the enqueue that may fill the cell next, or that position + 1 once it is filled. */
+        std::atomic<std::size_t> sequence;
+
+        /** The item held by the cell. */
+        ItemType item;
+    };
+
+    /** The ring of cells. */
+    std::unique_ptr<Cell[]> cells;
+
+    /** Number of cells minus one. The capacity is a power of two so positions wrap with this mask. */
+    std::size_t mask;
+
+    /** Position of the next enqueue. Only producers write it. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePosition;
+
+    /** Position of the next dequeue. Only consumers write it. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePosition;
+
+public:
+    /** Creates an empty queue.
+     * @param capacity The number of items the queue can hold, rounded up to a power of two of at least 2.
+     * @throws std::bad_alloc If the cells cannot be allocated. */
+    explicit LockFreeQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /** Copying a queue that other threads may be using is not supported. */
+    LockFreeQueue(const LockFreeQueue<ItemType>&) = delete;
+    LockFreeQueue<ItemType>& operator=(const LockFreeQueue<ItemType>&) = delete;
+
+    /** Destructor */
+    virtual ~LockFreeQueue() = default;
+
+    /** Sees whether this queue is empty. With other threads running, the answer may be out of date on return.
+     * @pre None
+     * @post Does not change the queue
+     * @return True if the queue is empty, or false if not. */
+    bool isEmpty() const noexcept override;
+
+    /** Adds a new entry to the back of this queue. Safe to call from any number of threads at once.
+     * @pre None
+     * @post If the operation was successful, the item is at the back of the queue.
+     * @param someItem The object to be added as a new entry.
+     * @return True if the addition is successful, or false if the queue is full. */
+    bool enqueue(const ItemType& someItem) override;
+
+    /** Removes the front of this queue and moves it into item. Safe to call from any number of threads at once.
+     * @pre None
+     * @post If the operation was successful, the front of the queue has been removed and is held by item.
+     * @param item Receives the front of the queue.
+     * @return True if an item was removed, or false if the queue is empty. */
+    bool tryDequeue(ItemType& item);
+
+    /** Removes the front of this queue, discarding it.
+     * @pre None
+     * @post If the operation was successful, the front of the queue has been removed.
+     * @return True if the removal is successful, or false if the queue is empty. */
+    bool dequeue() override;
+
+    /** Returns a copy of the front of this queue.
+     * @pre The queue is not empty, and no other thread dequeues while the copy is made.
+     * @post A copy of the front of the queue has been returned, and the queue is unchanged.
+     * @return A copy of the front of the queue.
+     * @throws PrecondViolatedExcept if the queue is empty. */
+    ItemType peekFront() const override;
+
+    /** Removes all entries from this queue.
+     * @pre None
+     * @post The queue is empty, apart from items enqueued by other threads meanwhile. */
+    void clear() override;
+
+    /** Gets the number of items in the queue. With other threads running, the count may be out of date on return.
+     * @pre None
+     * @post Does not change the queue.
+     * @return The number of items in the queue. */
+    std::size_t size() const noexcept;
+
+    /** Gets the number of items the queue can hold.
+     * @pre None
+     * @post Does not change the queue.
+     * @return The capacity of the queue. */
+    std::size_t getCapacity() const noexcept;
+}; // end LockFreeQueue
+
+#include "LockFreeQueue.cpp"
+#endif
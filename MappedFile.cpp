@@ -0,0 +1,122 @@
+/** @file MappedFile.cpp
+ * MappedFile maps a file read-only into memory.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename)
+    : mappedData(nullptr), mappedSize(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+{
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+        release();
+        throw std::runtime_error("Could not read size of file: " + filename);
+    }
+    mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+    if (mappedSize == 0) return;  // Empty files cannot be mapped and have nothing to read
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle != nullptr)
+    {
+        mappedData = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (mappedData == nullptr)
+    {
+        release();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+} // end constructor
+
+void MappedFile::release() noexcept
+{
+    if (mappedData != nullptr) UnmapViewOfFile(mappedData);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    mappedData = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappedSize = 0;
+} // end release
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) : mappedData(nullptr), mappedSize(0)
+{
+    int fileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        close(fileDescriptor);
+        throw std::runtime_error("Could not read size of file: " + filename);
+    }
+    mappedSize = static_cast<std::size_t>(fileStatus.st_size);
+
+    if (mappedSize > 0)  // Empty files cannot be mapped and have nothing to read
+    {
+        void* mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fileDescriptor);
+            throw std::runtime_error("Could not map file: " + filename);
+        }
+        madvise(mapping, mappedSize, MADV_SEQUENTIAL);  // Files are parsed front to back
+        mappedData = static_cast<const char*>(mapping);
+    }
+    close(fileDescriptor);  // The mapping stays valid after the descriptor is closed
+} // end constructor
+
+void MappedFile::release() noexcept
+{
+    if (mappedData != nullptr) munmap(const_cast<char*>(mappedData), mappedSize);
+    mappedData = nullptr;
+    mappedSize = 0;
+} // end release
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    release();
+} // end destructor
+
+const char* MappedFile::data() const noexcept
+{
+    return mappedData;
+} // end data
+
+std::size_t MappedFile::size() const noexcept
+{
+    return mappedSize;
+} // end size
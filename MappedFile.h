@@ -0,0 +1,58 @@
+/** @file MappedFile.h
+ * @class MappedFile
+ * Maps a whole file read-only into memory so it can be parsed in place without stream buffering or copies.
+ * Uses mmap on POSIX systems and file mappings on Windows. */
+
+#ifndef MAPPED_FILE_
+#define MAPPED_FILE_
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+class MappedFile
+{
+private:
+    /** Start of the mapped bytes, or nullptr for an empty file. */
+    const char* mappedData;
+
+    /** Number of mapped bytes. */
+    std::size_t mappedSize;
+
+#ifdef _WIN32
+    /** Handles of the open file and its mapping object. */
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    /** Unmaps the file and closes its handles. */
+    void release() noexcept;
+
+public:
+    /** Maps a file into memory.
+     * @param filename The name of the file to map.
+     * @throws std::runtime_error If the file cannot be opened or mapped. */
+    explicit MappedFile(const std::string& filename);
+
+    /** Copying a mapping is not supported. */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /** Destructor. Unmaps the file. */
+    virtual ~MappedFile();
+
+    /** Gets the mapped bytes.
+     * @pre None
+     * @post None
+     * @return A pointer to the first byte of the file, or nullptr if the file is empty. */
+    const char* data() const noexcept;
+
+    /** Gets the size of the file.
+     * @pre None
+     * @post None
+     * @return The number of mapped bytes. */
+    std::size_t size() const noexcept;
+}; // end MappedFile
+
+#include "MappedFile.cpp"
+#endif
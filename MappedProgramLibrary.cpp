@@ -0,0 +1,302 @@
+/** @file MappedProgramLibrary.cpp
+ * MappedProgramLibrary writes compiled programs to a binary file and evaluates them in place from a memory mapping.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "MappedProgramLibrary.h"
+
+// Instructions are viewed directly in the mapped file, so their layout in memory must match the format
+static_assert(sizeof(PostfixProgramView::Instruction) == 8, "Instructions must be 8-byte records");
+static_assert(offsetof(PostfixProgramView::Instruction, operand) == 4, "Instruction operands must follow 4 bytes in");
+static_assert(sizeof(double) == 8, "Constants must be 64-bit doubles");
+
+template<class ValueType>
+ValueType MappedProgramLibrary::readValue(const char* position) noexcept
+{
+    ValueType value;
+    std::memcpy(&value, position, sizeof(value));
+    return value;
+} // end readValue
+
+template<class ValueType>
+void MappedProgramLibrary::writeValue(std::string& buffer, std::size_t position, ValueType value) noexcept
+{
+    std::memcpy(&buffer[position], &value, sizeof(value));
+} // end writeValue
+
+bool MappedProgramLibrary::isLittleEndian() noexcept
+{
+    std::uint32_t one = 1;
+    unsigned char firstByte = 0;
+    std::memcpy(&firstByte, &one, 1);
+    return firstByte == 1;
+} // end isLittleEndian
+
+MappedProgramLibrary::MappedProgramLibrary(const std::string& filename)
+    : file(filename), programCount(0), nameCount(0), programTableOffset(0), nameTableOffset(0)
+{
+    validate();
+} // end constructor
+
+void MappedProgramLibrary::write(const std::string& filename,
+    const std::vector<std::shared_ptr<const PostfixProgram>>& programs)
+{
+    if (!isLittleEndian())
+    {
+        throw std::runtime_error("Program libraries can only be written on little-endian machines.");
+    }
+
+    // Give every variable past a-f one slot for the whole library
+    SymbolTable libraryNames;
+    std::vector<std::vector<PostfixProgramView::Instruction>> remapped(programs.size());
+    std::vector<std::uint32_t> slotCounts(programs.size(), 0);
+    for (std::size_t i = 0; i < programs.size(); ++i)
+    {
+        remapped[i].assign(programs[i]->begin(), programs[i]->end());
+        for (PostfixProgramView::Instruction& instruction : remapped[i])
+        {
+            if (instruction.opcode != PostfixProgram::OpCode::PushVariable) continue;
+            if (instruction.operand >= SymbolTable::PREDEFINED_COUNT)
+            {
+                instruction.operand = libraryNames.intern(programs[i]->getVariableName(instruction.operand));
+            }
+            if (instruction.operand >= slotCounts[i]) slotCounts[i] = instruction.operand + 1;
+        }
+    }
+    std::size_t libraryNameCount = libraryNames.size() - SymbolTable::PREDEFINED_COUNT;
+
+    // Fixed-size tables first, then the data of each program, each section starting at a multiple of 8 bytes
+    std::string buffer(HEADER_SIZE + programs.size() * PROGRAM_RECORD_SIZE + libraryNameCount * NAME_RECORD_SIZE, '\0');
+    auto appendAligned = [&buffer](const void* bytes, std::size_t byteCount)
+    {
+        std::size_t offset = (buffer.size() + 7) / 8 * 8;
+        buffer.resize(offset + byteCount, '\0');
+        if (byteCount > 0) std::memcpy(&buffer[offset], bytes, byteCount);
+        return static_cast<std::uint64_t>(offset);
+    };
+
+    for (std::size_t i = 0; i < programs.size(); ++i)
+    {
+        std::string records(remapped[i].size() * INSTRUCTION_SIZE, '\0');  // Padding bytes are always written as 0
+        for (std::size_t j = 0; j < remapped[i].size(); ++j)
+        {
+            records[j * INSTRUCTION_SIZE] = static_cast<char>(remapped[i][j].opcode);
+            writeValue(records, j * INSTRUCTION_SIZE + 4, remapped[i][j].operand);
+        }
+        const std::vector<double>& constants = programs[i]->getConstants();
+        std::string_view text = programs[i]->getPostfixText();
+
+        std::size_t record = HEADER_SIZE + i * PROGRAM_RECORD_SIZE;
+        std::uint64_t instructionOffset = appendAligned(records.data(), records.size());
+        std::uint64_t constantOffset = appendAligned(constants.data(), constants.size() * sizeof(double));
+        std::uint64_t textOffset = appendAligned(text.data(), text.size());
+        writeValue(buffer, record, instructionOffset);
+        writeValue(buffer, record + 8, constantOffset);
+        writeValue(buffer, record + 16, textOffset);
+        writeValue(buffer, record + 24, static_cast<std::uint32_t>(remapped[i].size()));
+        writeValue(buffer, record + 28, static_cast<std::uint32_t>(constants.size()));
+        writeValue(buffer, record + 32, static_cast<std::uint32_t>(text.size()));
+        writeValue(buffer, record + 36, static_cast<std::uint32_t>(programs[i]->getTemporaryCount()));
+        writeValue(buffer, record + 40, slotCounts[i]);
+    }
+
+    std::size_t libraryNameTableOffset = HEADER_SIZE + programs.size() * PROGRAM_RECORD_SIZE;
+    for (std::size_t i = 0; i < libraryNameCount; ++i)
+    {
+        std::string name = libraryNames.getName(static_cast<std::uint32_t>(SymbolTable::PREDEFINED_COUNT + i));
+        std::size_t record = libraryNameTableOffset + i * NAME_RECORD_SIZE;
+        std::uint64_t nameOffset = appendAligned(name.data(), name.size());
+        writeValue(buffer, record, nameOffset);
+        writeValue(buffer, record + 8, static_cast<std::uint32_t>(name.size()));
+    }
+    buffer.resize((buffer.size() + 7) / 8 * 8, '\0');
+
+    std::memcpy(&buffer[0], "PFXL", 4);
+    writeValue(buffer, 4, FORMAT_VERSION);
+    writeValue(buffer, 8, static_cast<std::uint32_t>(programs.size()));
+    writeValue(buffer, 12, static_cast<std::uint32_t>(libraryNameCount));
+    writeValue(buffer, 16, static_cast<std::uint64_t>(HEADER_SIZE));
+    writeValue(buffer, 24, static_cast<std::uint64_t>(libraryNameTableOffset));
+    writeValue(buffer, 32, static_cast<std::uint64_t>(buffer.size()));
+
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+    {
+        throw std::runtime_error("Could not write file: " + filename);
+    }
+} // end write
+
+void MappedProgramLibrary::validate()
+{
+    const char* base = file.data();
+    std::size_t fileSize = file.size();
+
+    // Checks that count elements of elementSize bytes starting at offset lie inside the file
+    auto fits = [fileSize](std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize)
+    {
+        return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+    };
+    auto fail = [](const std::string& reason)
+    {
+        throw std::runtime_error("Invalid program library: " + reason);
+    };
+
+    if (!isLittleEndian()) fail("only little-endian machines are supported");
+    if (fileSize < HEADER_SIZE || std::memcmp(base, "PFXL", 4) != 0) fail("missing header");
+    std::uint32_t version = readValue<std::uint32_t>(base + 4);
+    if (version != FORMAT_VERSION) fail("unsupported format version " + std::to_string(version));
+    if (readValue<std::uint64_t>(base + 32) != fileSize) fail("file size does not match header");
+
+    programCount = readValue<std::uint32_t>(base + 8);
+    nameCount = readValue<std::uint32_t>(base + 12);
+    std::uint64_t programTable = readValue<std::uint64_t>(base + 16);
+    std::uint64_t nameTable = readValue<std::uint64_t>(base + 24);
+    if (!fits(programTable, programCount, PROGRAM_RECORD_SIZE) || !fits(nameTable, nameCount, NAME_RECORD_SIZE))
+    {
+        fail("table out of range");
+    }
+    programTableOffset = static_cast<std::size_t>(programTable);
+    nameTableOffset = static_cast<std::size_t>(nameTable);
+
+    for (std::size_t i = 0; i < nameCount; ++i)
+    {
+        const char* record = base + nameTableOffset + i * NAME_RECORD_SIZE;
+        std::uint64_t nameOffset = readValue<std::uint64_t>(record);
+        std::uint32_t nameLength = readValue<std::uint32_t>(record + 8);
+        if (!fits(nameOffset, nameLength, 1)) fail("name out of range");
+        std::string_view name(base + nameOffset, nameLength);
+        if (!SymbolTable::isValidName(name)) fail("invalid variable name");
+    }
+
+    std::size_t librarySlotCount = getSlotCount();
+    programStatuses.assign(programCount, EvaluationStatus::InvalidExpression);
+    programStackDepths.assign(programCount, 0);
+    for (std::size_t i = 0; i < programCount; ++i)
+    {
+        ProgramRecord record = readProgramRecord(i);
+        if (record.instructionOffset % alignof(PostfixProgramView::Instruction) != 0 ||
+            record.constantOffset % alignof(double) != 0)
+        {
+            fail("misaligned program " + std::to_string(i));
+        }
+        if (!fits(record.instructionOffset, record.instructionCount, INSTRUCTION_SIZE) ||
+            !fits(record.constantOffset, record.constantCount, sizeof(double)) ||
+            !fits(record.textOffset, record.textLength, 1))
+        {
+            fail("program " + std::to_string(i) + " out of range");
+        }
+        if (record.slotCount > librarySlotCount || record.temporaryCount > record.instructionCount)
+        {
+            fail("program " + std::to_string(i) + " has invalid counts");
+        }
+
+        // Every operand must refer to storage that exists, so evaluation can index without checks
+        for (std::size_t j = 0; j < record.instructionCount; ++j)
+        {
+            const char* instruction = base + record.instructionOffset + j * INSTRUCTION_SIZE;
+            std::uint8_t opcode = static_cast<std::uint8_t>(instruction[0]);
+            std::uint32_t operand = readValue<std::uint32_t>(instruction + 4);
+            std::uint32_t limit = UINT32_MAX;
+            switch (static_cast<PostfixProgram::OpCode>(opcode))
+            {
+            case PostfixProgram::OpCode::PushVariable: limit = record.slotCount; break;
+            case PostfixProgram::OpCode::PushConstant: limit = record.constantCount; break;
+            case PostfixProgram::OpCode::StoreTemporary:
+            case PostfixProgram::OpCode::LoadTemporary: limit = record.temporaryCount; break;
+            default: break;
+            }
+            if (opcode > static_cast<std::uint8_t>(PostfixProgram::OpCode::Unknown) || operand >= limit)
+            {
+                fail("program " + std::to_string(i) + " has an invalid instruction");
+            }
+        }
+
+        // A malformed expression is still a valid library entry; its evaluations report the error
+        programStatuses[i] = PostfixProgramView::checkStructure(
+            reinterpret_cast<const PostfixProgramView::Instruction*>(base + record.instructionOffset),
+            record.instructionCount, record.temporaryCount, programStackDepths[i]);
+    }
+} // end validate
+
+MappedProgramLibrary::ProgramRecord MappedProgramLibrary::readProgramRecord(std::size_t index) const noexcept
+{
+    const char* record = file.data() + programTableOffset + index * PROGRAM_RECORD_SIZE;
+    ProgramRecord result;
+    result.instructionOffset = readValue<std::uint64_t>(record);
+    result.constantOffset = readValue<std::uint64_t>(record + 8);
+    result.textOffset = readValue<std::uint64_t>(record + 16);
+    result.instructionCount = readValue<std::uint32_t>(record + 24);
+    result.constantCount = readValue<std::uint32_t>(record + 28);
+    result.textLength = readValue<std::uint32_t>(record + 32);
+    result.temporaryCount = readValue<std::uint32_t>(record + 36);
+    result.slotCount = readValue<std::uint32_t>(record + 40);
+    return result;
+} // end readProgramRecord
+
+std::size_t MappedProgramLibrary::size() const noexcept
+{
+    return programCount;
+} // end size
+
+PostfixProgramView MappedProgramLibrary::getProgram(std::size_t index) const
+{
+    if (index >= programCount)
+    {
+        throw PrecondViolatedExcept("getProgram() called with an invalid program index.");
+    }
+    ProgramRecord record = readProgramRecord(index);
+    const char* base = file.data();
+
+    // validate() checked the layout and alignment, so the instructions and constants are used where they lie
+    return PostfixProgramView(reinterpret_cast<const PostfixProgramView::Instruction*>(base + record.instructionOffset),
+        record.instructionCount, reinterpret_cast<const double*>(base + record.constantOffset), record.constantCount,
+        record.temporaryCount, record.slotCount, std::string_view(base + record.textOffset, record.textLength),
+        programStatuses[index], programStackDepths[index]);
+} // end getProgram
+
+std::size_t MappedProgramLibrary::getSlotCount() const noexcept
+{
+    return SymbolTable::PREDEFINED_COUNT + nameCount;
+} // end getSlotCount
+
+std::string_view MappedProgramLibrary::getVariableName(std::uint32_t slot) const
+{
+    static constexpr std::string_view PREDEFINED_NAMES = "abcdef";
+    if (slot < SymbolTable::PREDEFINED_COUNT) return PREDEFINED_NAMES.substr(slot, 1);
+    if (slot >= getSlotCount())
+    {
+        throw PrecondViolatedExcept("getVariableName() called with an invalid variable slot.");
+    }
+    const char* record = file.data() + nameTableOffset + (slot - SymbolTable::PREDEFINED_COUNT) * NAME_RECORD_SIZE;
+    return std::string_view(file.data() + readValue<std::uint64_t>(record), readValue<std::uint32_t>(record + 8));
+} // end getVariableName
+
+std::shared_ptr<SymbolTable> MappedProgramLibrary::createSymbolTable() const
+{
+    std::shared_ptr<SymbolTable> symbols = std::make_shared<SymbolTable>();
+    for (std::uint32_t slot = SymbolTable::PREDEFINED_COUNT; slot < getSlotCount(); ++slot)
+    {
+        if (symbols->intern(getVariableName(slot)) != slot)  // A repeated name would shift the later slots
+        {
+            throw std::runtime_error("Invalid program library: repeated variable name");
+        }
+    }
+    return symbols;
+} // end createSymbolTable
+
+double MappedProgramLibrary::evaluate(std::size_t index, const double variableValues[], std::size_t valueCount) const
+{
+    PostfixProgramView program = getProgram(index);
+    if (program.getSlotCount() > valueCount)
+    {
+        throw std::runtime_error("Unknown variable: " + std::string(getVariableName(program.getSlotCount() - 1)));
+    }
+    return program.evaluate(variableValues, valueCount);
+} // end evaluate
+
+EvaluationResult MappedProgramLibrary::tryEvaluate(std::size_t index, const double variableValues[],
+    std::size_t valueCount) const
+{
+    return getProgram(index).tryEvaluate(variableValues, valueCount);
+} // end tryEvaluate
@@ -0,0 +1,192 @@
+/** @file MappedProgramLibrary.h
+ * @class MappedProgramLibrary
+ * Read-only library of compiled postfix programs stored in a versioned binary file. The file is written once with
+ * write() and memory mapped at startup, so loading many programs costs one pass of validation instead of converting
+ * every expression again. Programs are evaluated in place through a PostfixProgramView; nothing is copied.
+ *
+ * All numbers are little-endian and every section starts at a multiple of 8 bytes:
+ *   Header         magic "PFXL", format version, program count, name count, program table offset,
+ *                  name table offset and file size (40 bytes)
+ *   Program table  per program: instruction, constant and text offsets, instruction, constant and text lengths,
+ *                  temporary count and slot count (48 bytes each)
+ *   Name table     per variable name past a-f: offset and length (16 bytes each); name i has slot 6 + i
+ *   Data           instructions as 8-byte records (opcode byte, 3 bytes of padding, 32-bit operand), constants
+ *                  as 64-bit doubles, postfix and name text */
+
+#ifndef MAPPED_PROGRAM_LIBRARY_
+#define MAPPED_PROGRAM_LIBRARY_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "PostfixProgram.h"
+#include "PostfixProgramView.h"
+#include "SymbolTable.h"
+#include "PrecondViolatedExcept.h"
+
+class MappedProgramLibrary
+{
+public:
+    /** Version of the file format written by write(). Files of other versions are rejected. */
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+private:
+    /** Sizes of the fixed parts of the format, in bytes. */
+    static constexpr std::size_t HEADER_SIZE = 40;
+    static constexpr std::size_t PROGRAM_RECORD_SIZE = 48;
+    static constexpr std::size_t NAME_RECORD_SIZE = 16;
+    static constexpr std::size_t INSTRUCTION_SIZE = 8;
+
+    /** Location of one program in the data section. */
+    struct ProgramRecord
+    {
+        std::uint64_t instructionOffset;
+        std::uint64_t constantOffset;
+        std::uint64_t textOffset;
+        std::uint32_t instructionCount;
+        std::uint32_t constantCount;
+        std::uint32_t textLength;
+        std::uint32_t temporaryCount;
+        std::uint32_t slotCount;
+    };
+
+    /** The mapped library file. */
+    MappedFile file;
+
+    /** Number of programs in the library. */
+    std::size_t programCount;
+
+    /** Number of variable names past a-f. */
+    std::size_t nameCount;
+
+    /** Offsets of the program and name tables. */
+    std::size_t programTableOffset;
+    std::size_t nameTableOffset;
+
+    /** Whether each program is a valid postfix program, checked once when the library is loaded. */
+    std::vector<EvaluationStatus> programStatuses;
+
+    /** Deepest evaluation stack of each program, found together with its status. */
+    std::vector<std::size_t> programStackDepths;
+
+    /** Reads a number stored at any alignment in the file.
+     * @pre position has room for the number.
+     * @post None
+     * @param position The first byte of the number.
+     * @return The number. */
+    template<class ValueType>
+    static ValueType readValue(const char* position) noexcept;
+
+    /** Stores a number into a buffer being written.
+     * @pre buffer has room for the number at position.
+     * @post The bytes of the number are at position.
+     * @param buffer The buffer.
+     * @param position The offset of the first byte.
+     * @param value The number. */
+    template<class ValueType>
+    static void writeValue(std::string& buffer, std::size_t position, ValueType value) noexcept;
+
+    /** Checks whether numbers are stored little-endian on this machine, as in the file format.
+     * @pre None
+     * @post None
+     * @return True on little-endian machines. */
+    static bool isLittleEndian() noexcept;
+
+    /** Reads the record of a program.
+     * @pre index is less than programCount.
+     * @post None
+     * @param index The index of the program.
+     * @return The record of the program. */
+    ProgramRecord readProgramRecord(std::size_t index) const noexcept;
+
+    /** Checks that the mapped file is a library of this format version whose offsets, names and instruction
+     * operands are all in range, so programs can later be viewed without further checks.
+     * @pre None
+     * @post None
+     * @throws std::runtime_error If the file is not a valid library. */
+    void validate();
+
+public:
+    /** Maps a library file into memory and validates it.
+     * @param filename The name of the library file.
+     * @throws std::runtime_error If the file cannot be opened or is not a valid library. */
+    explicit MappedProgramLibrary(const std::string& filename);
+
+    /** Writes compiled programs to a library file. Variable names past a-f are gathered into one table for the
+     * whole library, so the slots of a program in the file can differ from its slots in memory.
+     * @pre None
+     * @post The file holds the programs in the given order.
+     * @param filename The name of the library file to write.
+     * @param programs The programs to write.
+     * @throws std::runtime_error If the file cannot be written.
+     * @throws PrecondViolatedExcept If a program uses a variable slot that has no name. */
+    static void write(const std::string& filename, const std::vector<std::shared_ptr<const PostfixProgram>>& programs);
+
+    /** Gets the number of programs in the library.
+     * @pre None
+     * @post None
+     * @return The number of programs. */
+    std::size_t size() const noexcept;
+
+    /** Gets a program without copying it.
+     * @pre None
+     * @post None
+     * @param index The index of the program, in the order the programs were written.
+     * @return A view of the program, valid for the lifetime of the library.
+     * @throws PrecondViolatedExcept If index is out of range. */
+    PostfixProgramView getProgram(std::size_t index) const;
+
+    /** Gets the number of variable slots used by the library, which is the number of values evaluation needs.
+     * @pre None
+     * @post None
+     * @return SymbolTable::PREDEFINED_COUNT plus the number of names in the library. */
+    std::size_t getSlotCount() const noexcept;
+
+    /** Gets the name of a variable slot without copying it.
+     * @pre None
+     * @post None
+     * @param slot The slot.
+     * @return The lowercase name of the variable.
+     * @throws PrecondViolatedExcept If the library has no such slot. */
+    std::string_view getVariableName(std::uint32_t slot) const;
+
+    /** Creates a symbol table that assigns the library's slots to its variable names, for setting values by name.
+     * @pre None
+     * @post None
+     * @return A new table whose slots match the slots of the library. */
+    std::shared_ptr<SymbolTable> createSymbolTable() const;
+
+    /** Evaluates a program against a table of variable values, naming any missing variable.
+     * @pre variableValues holds valueCount values.
+     * @post None
+     * @param index The index of the program.
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a slot that has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs.
+     * @throws PrecondViolatedExcept If index is out of range. */
+    double evaluate(std::size_t index, const double variableValues[], std::size_t valueCount) const;
+
+    /** Evaluates a program against a table of variable values without throwing for evaluation errors.
+     * @pre variableValues holds valueCount values.
+     * @post None
+     * @param index The index of the program.
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero.
+     * @throws PrecondViolatedExcept If index is out of range. */
+    EvaluationResult tryEvaluate(std::size_t index, const double variableValues[], std::size_t valueCount) const;
+}; // end MappedProgramLibrary
+
+#include "MappedProgramLibrary.cpp"
+#endif
@@ -0,0 +1,58 @@
+/** @file ParallelEvaluator.cpp
+ * ParallelEvaluator splits batch evaluation into row chunks that run on a work-stealing thread pool.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "ParallelEvaluator.h"
+
+ParallelEvaluator::ParallelEvaluator(std::size_t workerCount, std::size_t rowsPerChunk)
+    : pool(workerCount), chunkRows(rowsPerChunk == 0 ? DEFAULT_CHUNK_ROWS : rowsPerChunk)
+{ } // end constructor
+
+std::size_t ParallelEvaluator::getWorkerCount() const noexcept
+{
+    return pool.getWorkerCount();
+} // end getWorkerCount
+
+void ParallelEvaluator::evaluateBatch(const PostfixProgram& program, const VariableColumns& columns, double results[])
+{
+    const BatchKernels::KernelTable& kernels = BatchKernels::select();
+    std::size_t rowCount = columns.getRowCount();
+    std::size_t chunkCount = (rowCount + chunkRows - 1) / chunkRows;
+
+    // Each chunk writes only its own slice of results, so the output order does not depend on scheduling
+    pool.parallelFor(chunkCount, [&](std::size_t chunk)
+        {
+            std::size_t firstRow = chunk * chunkRows;
+            std::size_t rows = rowCount - firstRow < chunkRows ? rowCount - firstRow : chunkRows;
+            program.evaluateBatchRange(columns, firstRow, rows, results + firstRow, kernels);
+        });
+} // end evaluateBatch
+
+std::vector<double> ParallelEvaluator::evaluateBatch(const PostfixProgram& program, const VariableColumns& columns)
+{
+    std::vector<double> results(columns.getRowCount());
+    evaluateBatch(program, columns, results.data());
+    return results;
+} // end evaluateBatch
+
+std::vector<std::vector<double>> ParallelEvaluator::evaluateMany(
+    const std::vector<std::shared_ptr<const PostfixProgram>>& programs, const VariableColumns& columns)
+{
+    const BatchKernels::KernelTable& kernels = BatchKernels::select();
+    std::size_t rowCount = columns.getRowCount();
+    std::size_t chunkCount = (rowCount + chunkRows - 1) / chunkRows;
+    std::vector<std::vector<double>> results(programs.size(), std::vector<double>(rowCount));
+
+    // Tasks are numbered program by program, so the lowest failing task is in the first failing program
+    pool.parallelFor(programs.size() * chunkCount, [&](std::size_t task)
+        {
+            std::size_t programIndex = task / chunkCount;
+            std::size_t firstRow = (task % chunkCount) * chunkRows;
+            std::size_t rows = rowCount - firstRow < chunkRows ? rowCount - firstRow : chunkRows;
+            programs[programIndex]->evaluateBatchRange(columns, firstRow, rows,
+                results[programIndex].data() + firstRow, kernels);
+        });
+    return results;
+} // end evaluateMany
@@ -0,0 +1,74 @@
+/** @file ParallelEvaluator.h
+ * @class ParallelEvaluator
+ * Evaluates compiled programs over large sets of variable columns on a WorkStealingPool. Rows are split into
+ * chunks that run concurrently, and every chunk writes its own slice of the results, so results always come out
+ * in row order. */
+
+#ifndef PARALLEL_EVALUATOR_
+#define PARALLEL_EVALUATOR_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "PostfixProgram.h"
+#include "VariableColumns.h"
+#include "WorkStealingPool.h"
+
+class ParallelEvaluator
+{
+private:
+    /** The threads that evaluate chunks. */
+    WorkStealingPool pool;
+
+    /** Number of rows in each chunk of work. */
+    std::size_t chunkRows;
+
+public:
+    /** Default number of rows per chunk, large enough to amortize scheduling and small enough to balance load. */
+    static constexpr std::size_t DEFAULT_CHUNK_ROWS = 64 * PostfixProgram::BLOCK_SIZE;
+
+    /** Creates an evaluator and starts its worker threads.
+     * @param workerCount The number of worker threads. 0 uses one worker per hardware thread.
+     * @param rowsPerChunk The number of rows evaluated by each task. 0 uses DEFAULT_CHUNK_ROWS. */
+    explicit ParallelEvaluator(std::size_t workerCount = 0, std::size_t rowsPerChunk = DEFAULT_CHUNK_ROWS);
+
+    /** Gets the number of worker threads.
+     * @pre None
+     * @post None
+     * @return The number of worker threads. */
+    std::size_t getWorkerCount() const noexcept;
+
+    /** Evaluates one program over every row of a set of variable columns in parallel.
+     * @pre results has room for columns.getRowCount() values.
+     * @post Does not change the program or the columns.
+     * @param program The compiled program to evaluate.
+     * @param columns The variable values, one column per variable.
+     * @param results The array that receives one result per row, in row order.
+     * @throws std::runtime_error If the program is invalid or division by zero occurs in any row. The error of the
+     * lowest failing chunk is reported. */
+    void evaluateBatch(const PostfixProgram& program, const VariableColumns& columns, double results[]);
+
+    /** Evaluates one program over every row of a set of variable columns in parallel.
+     * @pre None
+     * @post Does not change the program or the columns.
+     * @param program The compiled program to evaluate.
+     * @param columns The variable values, one column per variable.
+     * @return One result per row, in row order.
+     * @throws std::runtime_error If the program is invalid or division by zero occurs in any row. */
+    std::vector<double> evaluateBatch(const PostfixProgram& program, const VariableColumns& columns);
+
+    /** Evaluates a set of programs over every row of a set of variable columns in parallel. Both programs and row
+     * chunks are spread across the workers.
+     * @pre Every program pointer is not null.
+     * @post Does not change the programs or the columns.
+     * @param programs The compiled programs to evaluate.
+     * @param columns The variable values, one column per variable.
+     * @return One vector of results per program, in the order of programs, each in row order.
+     * @throws std::runtime_error If any program is invalid or division by zero occurs in any row. The error of the
+     * first failing program and chunk is reported. */
+    std::vector<std::vector<double>> evaluateMany(const std::vector<std::shared_ptr<const PostfixProgram>>& programs,
+        const VariableColumns& columns);
+}; // end ParallelEvaluator
+
+#include "ParallelEvaluator.cpp"
+#endif
@@ -0,0 +1,111 @@
+/** @file PostfixOptimizer.cpp
+ * PostfixOptimizer emits shorter programs from the expression graph of a compiled program.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "PostfixOptimizer.h"
+
+PostfixOptimizer::PostfixOptimizer()
+{ } // end default constructor
+
+PostfixOptimizer::PostfixOptimizer(ExpressionDag::Options optimizerOptions) : options(optimizerOptions)
+{ } // end constructor
+
+std::shared_ptr<const PostfixProgram> PostfixOptimizer::optimize(
+    const std::shared_ptr<const PostfixProgram>& program) const
+{
+    using OpCode = PostfixProgram::OpCode;
+    using NodeKind = ExpressionDag::NodeKind;
+
+    ExpressionDag dag(options);
+    std::size_t root;
+    try
+    {
+        root = dag.addProgram(*program);
+    }
+    catch (const std::runtime_error&)
+    {
+        return program;  // Leave invalid programs alone so evaluation reports the same error
+    }
+
+    // Count the uses of each node reachable from the root. Ids are topological, so parents come before children
+    // when walking down from the root.
+    std::vector<std::size_t> useCount(root + 1, 0);
+    std::vector<bool> reachable(root + 1, false);
+    reachable[root] = true;
+    for (std::size_t id = root + 1; id-- > 0;)
+    {
+        const ExpressionDag::Node& node = dag.getNode(id);
+        if (!reachable[id] || node.left == ExpressionDag::NO_NODE) continue;
+        ++useCount[node.left];
+        ++useCount[node.right];
+        reachable[node.left] = true;
+        reachable[node.right] = true;
+    }
+
+    std::vector<PostfixProgram::Instruction> instructions;
+    std::vector<double> constants;
+    std::vector<std::uint32_t> constantIndex(root + 1, UINT32_MAX);
+    std::vector<std::uint32_t> temporaryIndex(root + 1, UINT32_MAX);
+    std::uint32_t temporaryCount = 0;
+
+    // Emit the graph in postorder with an explicit stack, so deeply nested expressions do not exhaust the call stack
+    std::vector<std::pair<std::size_t, bool>> pending;  // Node id and whether its operands were already emitted
+    pending.emplace_back(root, false);
+    while (!pending.empty())
+    {
+        auto [id, operandsEmitted] = pending.back();
+        pending.pop_back();
+        const ExpressionDag::Node& node = dag.getNode(id);
+
+        if (node.kind == NodeKind::Variable)
+        {
+            instructions.push_back({ OpCode::PushVariable, node.slot });
+        }
+        else if (node.kind == NodeKind::Constant)
+        {
+            if (constantIndex[id] == UINT32_MAX)
+            {
+                constantIndex[id] = static_cast<std::uint32_t>(constants.size());
+                constants.push_back(node.value);
+            }
+            instructions.push_back({ OpCode::PushConstant, constantIndex[id] });
+        }
+        else if (temporaryIndex[id] != UINT32_MAX)  // Shared subexpression that was already computed
+        {
+            instructions.push_back({ OpCode::LoadTemporary, temporaryIndex[id] });
+        }
+        else if (!operandsEmitted)
+        {
+            pending.emplace_back(id, true);
+            pending.emplace_back(node.right, false);
+            pending.emplace_back(node.left, false);
+        }
+        else
+        {
+            OpCode opcode = OpCode::Add;
+            switch (node.kind)
+            {
+            case NodeKind::Subtract: opcode = OpCode::Subtract; break;
+            case NodeKind::Multiply: opcode = OpCode::Multiply; break;
+            case NodeKind::Divide: opcode = OpCode::Divide; break;
+            default: break;
+            }
+            instructions.push_back({ opcode, 0 });
+
+            if (useCount[id] > 1)  // Keep the value for the later uses
+            {
+                temporaryIndex[id] = temporaryCount++;
+                instructions.push_back({ OpCode::StoreTemporary, temporaryIndex[id] });
+            }
+        }
+    }
+
+    if (instructions.size() >= program->size())
+    {
+        return program;
+    }
+    return std::make_shared<const PostfixProgram>(std::move(instructions), std::move(constants), temporaryCount,
+        std::string(program->getPostfixText()), program->getSymbolTable());
+} // end optimize
@@ -0,0 +1,46 @@
+/** @file PostfixOptimizer.h
+ * @class PostfixOptimizer
+ * Rewrites compiled postfix programs into shorter equivalent programs. The program is turned into an ExpressionDag,
+ * which folds constants, simplifies identities and merges repeated subexpressions, and the graph is emitted again
+ * with each shared subexpression computed once and kept in a temporary. Results, including division by zero and
+ * the errors of invalid programs, are the same as for the original program. */
+
+#ifndef POSTFIX_OPTIMIZER_
+#define POSTFIX_OPTIMIZER_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PostfixProgram.h"
+#include "ExpressionDag.h"
+
+class PostfixOptimizer
+{
+private:
+    /** Simplification rules passed to the expression graph. */
+    ExpressionDag::Options options;
+
+public:
+    /** Default constructor. Only applies rewrites that are exact for every IEEE value. */
+    PostfixOptimizer();
+
+    /** Creates an optimizer with given simplification rules.
+     * @pre None
+     * @post The optimizer uses the given rules.
+     * @param optimizerOptions The simplification rules. */
+    explicit PostfixOptimizer(ExpressionDag::Options optimizerOptions);
+
+    /** Optimizes a compiled program.
+     * @pre None
+     * @post Does not change the program.
+     * @param program The program to optimize.
+     * @return A shorter program that computes the same result and keeps the original postfix text, or the given
+     * program if it is invalid or cannot be shortened. */
+    std::shared_ptr<const PostfixProgram> optimize(const std::shared_ptr<const PostfixProgram>& program) const;
+}; // end PostfixOptimizer
+
+#include "PostfixOptimizer.cpp"
+#endif
@@ -0,0 +1,264 @@
+/** @file PostfixProgram.cpp
+ * PostfixProgram compiles a postfix expression into a flat instruction array and evaluates it without consuming it.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "PostfixProgram.h"
+
+constexpr int PostfixProgram::precedence(char operatorChar) noexcept
+{
+    if (operatorChar == '+' || operatorChar == '-')
+    {
+        return 1; // Operators '+' and '-' have a precedence of 1
+    }
+    if (operatorChar == '*' || operatorChar == '/')
+    {
+        return 2; // Operators '*' and '/' have a precedence of 2
+    }
+    return 0;
+} // end precedence
+
+PostfixProgram::PostfixProgram()
+    : temporaryCount(0), slotCount(0), status(EvaluationStatus::InvalidExpression), maxStackDepth(0)
+{ } // end default constructor
+
+PostfixProgram::PostfixProgram(std::string postfixExpression) : PostfixProgram(std::move(postfixExpression), nullptr)
+{ } // end constructor
+
+PostfixProgram::PostfixProgram(std::string postfixExpression, std::shared_ptr<SymbolTable> symbols)
+    : temporaryCount(0), slotCount(0), postfixText(std::move(postfixExpression)),
+    status(EvaluationStatus::InvalidExpression), maxStackDepth(0)
+{
+    instructions.reserve(postfixText.size());
+    std::string_view text = postfixText;
+
+    // Compact form, one character per token. Text without spaces or operators is a single operand instead, since
+    // a compact program of more than one operand needs an operator.
+    if (text.find(' ') == std::string_view::npos && text.find_first_of("+-*/") != std::string_view::npos)
+    {
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            appendToken(text.substr(i, 1), symbols);
+        }
+    }
+    else
+    {
+        std::size_t position = 0;
+        while (position < text.size())
+        {
+            std::size_t tokenEnd = text.find(' ', position);
+            if (tokenEnd == std::string_view::npos) tokenEnd = text.size();
+            if (tokenEnd > position) appendToken(text.substr(position, tokenEnd - position), symbols);
+            position = tokenEnd + 1;
+        }
+    }
+    checkStructure();
+} // end constructor
+
+PostfixProgram::PostfixProgram(std::vector<Instruction> programInstructions, std::vector<double> programConstants,
+    std::size_t programTemporaryCount, std::string postfixExpression, std::shared_ptr<SymbolTable> symbols)
+    : instructions(std::move(programInstructions)), constants(std::move(programConstants)),
+    temporaryCount(programTemporaryCount), slotCount(0), symbolTable(std::move(symbols)),
+    postfixText(std::move(postfixExpression)), status(EvaluationStatus::InvalidExpression), maxStackDepth(0)
+{
+    for (const Instruction& instruction : instructions)
+    {
+        if (instruction.opcode == OpCode::PushVariable && instruction.operand >= slotCount)
+        {
+            slotCount = instruction.operand + 1;
+        }
+    }
+    checkStructure();
+} // end constructor
+
+void PostfixProgram::checkStructure()
+{
+    status = PostfixProgramView::checkStructure(instructions.data(), instructions.size(), temporaryCount,
+        maxStackDepth);
+} // end checkStructure
+
+void PostfixProgram::appendToken(std::string_view token, std::shared_ptr<SymbolTable>& symbols)
+{
+    Instruction instruction = { OpCode::Unknown, static_cast<unsigned char>(token[0]) };  // Keep the character for error reporting
+    unsigned char firstChar = static_cast<unsigned char>(token[0]);
+
+    if (std::isalpha(firstChar) && SymbolTable::isValidName(token))  // Variable
+    {
+        char lowerChar = static_cast<char>(std::tolower(firstChar));
+        if (token.size() == 1 && lowerChar - 'a' < static_cast<int>(SymbolTable::PREDEFINED_COUNT))
+        {
+            instruction.operand = static_cast<std::uint32_t>(lowerChar - 'a');  // Variables a-f never need the table
+        }
+        else
+        {
+            if (!symbols) symbols = std::make_shared<SymbolTable>();
+            instruction.operand = symbols->intern(token);
+            symbolTable = symbols;
+        }
+        instruction.opcode = OpCode::PushVariable;
+        if (instruction.operand >= slotCount) slotCount = instruction.operand + 1;
+    }
+    else if (std::isdigit(firstChar) || firstChar == '.')  // Literal
+    {
+        double value = 0;
+        std::from_chars_result parsed = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (parsed.ec == std::errc() && parsed.ptr == token.data() + token.size())
+        {
+            instruction.opcode = OpCode::PushConstant;
+            instruction.operand = static_cast<std::uint32_t>(constants.size());
+            constants.push_back(value);
+        }
+    }
+    else if (token.size() == 1)  // Operator
+    {
+        switch (firstChar)
+        {
+        case '+': instruction = { OpCode::Add, 0 }; break;
+        case '-': instruction = { OpCode::Subtract, 0 }; break;
+        case '*': instruction = { OpCode::Multiply, 0 }; break;
+        case '/': instruction = { OpCode::Divide, 0 }; break;
+        default: break;
+        }
+    }
+    instructions.push_back(instruction);
+} // end appendToken
+
+EvaluationStatus PostfixProgram::getStatus() const noexcept
+{
+    return status;
+} // end getStatus
+
+std::size_t PostfixProgram::getMaxStackDepth() const noexcept
+{
+    return maxStackDepth;
+} // end getMaxStackDepth
+
+std::uint32_t PostfixProgram::getSlotCount() const noexcept
+{
+    return slotCount;
+} // end getSlotCount
+
+const std::shared_ptr<SymbolTable>& PostfixProgram::getSymbolTable() const noexcept
+{
+    return symbolTable;
+} // end getSymbolTable
+
+std::string PostfixProgram::getVariableName(std::uint32_t slot) const
+{
+    if (slot < SymbolTable::PREDEFINED_COUNT) return std::string(1, static_cast<char>('a' + slot));
+    if (symbolTable && slot < symbolTable->size()) return symbolTable->getName(slot);
+    return "#" + std::to_string(slot);  // Program built from instructions without names
+} // end getVariableName
+
+void PostfixProgram::checkSlotCount(std::size_t valueCount) const
+{
+    if (slotCount > valueCount)
+    {
+        throw std::runtime_error("Unknown variable: " + getVariableName(slotCount - 1));
+    }
+} // end checkSlotCount
+
+const std::vector<double>& PostfixProgram::getConstants() const noexcept
+{
+    return constants;
+} // end getConstants
+
+std::size_t PostfixProgram::getTemporaryCount() const noexcept
+{
+    return temporaryCount;
+} // end getTemporaryCount
+
+std::string_view PostfixProgram::getPostfixText() const noexcept
+{
+    return postfixText;
+} // end getPostfixText
+
+std::size_t PostfixProgram::size() const noexcept
+{
+    return instructions.size();
+} // end size
+
+bool PostfixProgram::isEmpty() const noexcept
+{
+    return instructions.empty();
+} // end isEmpty
+
+PostfixProgramView PostfixProgram::getView() const noexcept
+{
+    return PostfixProgramView(instructions.data(), instructions.size(), constants.data(), constants.size(),
+        temporaryCount, slotCount, postfixText, status, maxStackDepth);
+} // end getView
+
+const PostfixProgram::Instruction* PostfixProgram::begin() const noexcept
+{
+    return instructions.data();
+} // end begin
+
+const PostfixProgram::Instruction* PostfixProgram::end() const noexcept
+{
+    return instructions.data() + instructions.size();
+} // end end
+
+double PostfixProgram::evaluate(const int variableValues[]) const
+{
+    checkSlotCount(SymbolTable::PREDEFINED_COUNT);
+    return getView().evaluate(variableValues);
+} // end evaluate
+
+double PostfixProgram::evaluate(const double variableValues[], std::size_t valueCount) const
+{
+    checkSlotCount(valueCount);
+    return getView().evaluate(variableValues, valueCount);
+} // end evaluate
+
+EvaluationResult PostfixProgram::tryEvaluate(const double variableValues[], std::size_t valueCount) const
+{
+    return getView().tryEvaluate(variableValues, valueCount);
+} // end tryEvaluate
+
+void PostfixProgram::evaluateBatch(const VariableColumns& columns, double results[]) const
+{
+    evaluateBatch(columns, results, BatchKernels::select());
+} // end evaluateBatch
+
+void PostfixProgram::evaluateBatch(const VariableColumns& columns, double results[],
+    const BatchKernels::KernelTable& kernels) const
+{
+    evaluateBatchRange(columns, 0, columns.getRowCount(), results, kernels);
+} // end evaluateBatch
+
+void PostfixProgram::evaluateBatchRange(const VariableColumns& columns, std::size_t firstRow, std::size_t rowCount,
+    double results[], const BatchKernels::KernelTable& kernels) const
+{
+    checkSlotCount(columns.getColumnCount());  // Report missing variables by name before the view does by slot
+    getView().evaluateBatchRange(columns, firstRow, rowCount, results, kernels);
+} // end evaluateBatchRange
+
+BatchEvaluationResult PostfixProgram::tryEvaluateBatch(const VariableColumns& columns) const
+{
+    return tryEvaluateBatch(columns, BatchKernels::select());
+} // end tryEvaluateBatch
+
+BatchEvaluationResult PostfixProgram::tryEvaluateBatch(const VariableColumns& columns,
+    const BatchKernels::KernelTable& kernels) const
+{
+    std::size_t rowCount = columns.getRowCount();
+    BatchEvaluationResult batch = { EvaluationStatus::Ok, std::vector<double>(rowCount),
+        std::vector<std::uint64_t>((rowCount + 63) / 64), 0 };
+
+    batch.status = getView().tryEvaluateBatchRange(columns, 0, rowCount, batch.values.data(),
+        batch.rowErrors.data(), kernels);
+    if (batch.status != EvaluationStatus::Ok)
+    {
+        batch.values.clear();
+        batch.rowErrors.clear();
+        return batch;
+    }
+
+    for (std::uint64_t errorWord : batch.rowErrors)
+    {
+        batch.errorCount += static_cast<std::size_t>(std::bitset<64>(errorWord).count());
+    }
+    return batch;
+} // end tryEvaluateBatch
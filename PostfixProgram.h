@@ -0,0 +1,296 @@
+/** @file PostfixProgram.h
+ * @class PostfixProgram
+ * Immutable compiled form of a postfix expression stored as a flat array of instructions. A program is produced once
+ * by InfixToPostfixEvaluation and can be evaluated any number of times against different variable values. Variables
+ * are referenced by the dense slots of a SymbolTable, so evaluation is a plain array lookup. Evaluation runs over
+ * a PostfixProgramView of the program. The structure of the program is checked once when it is built, and the
+ * tryEvaluate functions report errors as an EvaluationStatus instead of throwing. */
+
+#ifndef POSTFIX_PROGRAM_
+#define POSTFIX_PROGRAM_
+
+#include <cstddef>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+#include <memory>
+#include <charconv>
+#include <bitset>
+#include "SymbolTable.h"
+#include "PostfixProgramView.h"
+#include "ExpressionTokenizer.h"
+#include "VariableColumns.h"
+#include "BatchKernels.h"
+#include "PostfixStatistics.h"
+
+class PostfixProgram
+{
+public:
+    /** Operation codes of the instructions in a compiled program. */
+    using OpCode = PostfixProgramView::OpCode;
+
+    /** A single instruction of a compiled program. */
+    using Instruction = PostfixProgramView::Instruction;
+
+private:
+    /** Flat array of instructions in postfix order. */
+    std::vector<Instruction> instructions;
+
+    /** Constants referenced by PushConstant instructions. */
+    std::vector<double> constants;
+
+    /** Number of temporaries used by StoreTemporary and LoadTemporary instructions. */
+    std::size_t temporaryCount;
+
+    /** One more than the largest variable slot used, so values for slots 0 to slotCount-1 are needed. */
+    std::uint32_t slotCount;
+
+    /** Names of slots past the predefined variables a-f, or nullptr if the program only uses a-f. */
+    std::shared_ptr<SymbolTable> symbolTable;
+
+    /** The postfix expression the program was compiled from, kept for logging and display. */
+    std::string postfixText;
+
+    /** Whether the instructions form a valid program, found once when the program is built. */
+    EvaluationStatus status;
+
+    /** Maximum number of values on the evaluation stack, found once when the program is built. */
+    std::size_t maxStackDepth;
+
+    /** Checks the structure of the instructions and records the result and the deepest stack.
+     * @pre The instructions are complete.
+     * @post status and maxStackDepth are set.
+     * @throws std::bad_alloc If the record of stored temporaries cannot be allocated. */
+    void checkStructure();
+
+    /** Adds the instruction for one token of postfix text.
+     * @pre None
+     * @post The instruction is appended and slotCount covers its variable.
+     * @param token The text of the token.
+     * @param symbols The table that names variables past a-f, created when first needed. */
+    void appendToken(std::string_view token, std::shared_ptr<SymbolTable>& symbols);
+
+    /** Checks that the program only uses slots that have values.
+     * @pre None
+     * @post None
+     * @param valueCount The number of values available.
+     * @throws std::runtime_error If the program uses a slot of valueCount or more. */
+    void checkSlotCount(std::size_t valueCount) const;
+
+public:
+    /** Number of rows evaluated together by each operation in batch evaluation. */
+    static constexpr std::size_t BLOCK_SIZE = PostfixProgramView::BLOCK_SIZE;
+
+    /** Determines the precedence of an operator. Shared by the runtime and compile-time converters so both
+     * follow the same rules.
+     * @pre None
+     * @post None
+     * @param operatorChar The operator character to check.
+     * @return 2 for '*' and '/', 1 for '+' and '-', and 0 for any other character. */
+    static constexpr int precedence(char operatorChar) noexcept;
+
+    /** Default constructor. Creates an empty program. */
+    PostfixProgram();
+
+    /** Compiles a postfix expression of variables, literals and operators +,-,*,/ into a program. Without spaces
+     * every character is one token, as in "ab+c*", unless the text has no operators and so is a single operand.
+     * With spaces, tokens are separated by spaces, as in "price 2.5 *". Variables a-f use slots 0-5 and other names get slots in order of first appearance.
+     * @pre None
+     * @post The program holds one instruction per token of the postfix expression.
+     * @param postfixExpression The postfix expression to compile. The program keeps it as its postfix text. */
+    explicit PostfixProgram(std::string postfixExpression);
+
+    /** Compiles a postfix expression, interning variable names other than a-f in a symbol table.
+     * @pre None
+     * @post The program holds one instruction per token of the postfix expression.
+     * @param postfixExpression The postfix expression to compile. The program keeps it as its postfix text.
+     * @param symbols The table that assigns slots to variable names. */
+    PostfixProgram(std::string postfixExpression, std::shared_ptr<SymbolTable> symbols);
+
+    /** Creates a program from already generated instructions, for example the output of PostfixOptimizer.
+     * @pre Every operand refers to a valid constant or temporary.
+     * @post The program holds the given instructions.
+     * @param programInstructions The instructions in postfix order.
+     * @param programConstants The constants referenced by PushConstant instructions.
+     * @param programTemporaryCount The number of temporaries the instructions use.
+     * @param postfixExpression The postfix expression the instructions compute, kept as the postfix text.
+     * @param symbols The table that names the variable slots, or nullptr if only a-f are used. */
+    PostfixProgram(std::vector<Instruction> programInstructions, std::vector<double> programConstants,
+        std::size_t programTemporaryCount, std::string postfixExpression, std::shared_ptr<SymbolTable> symbols = nullptr);
+
+    /** Gets the constants referenced by PushConstant instructions.
+     * @pre None
+     * @post Does not change the program.
+     * @return The constants, indexed by operand. */
+    const std::vector<double>& getConstants() const noexcept;
+
+    /** Gets the number of temporaries used by StoreTemporary and LoadTemporary instructions.
+     * @pre None
+     * @post Does not change the program.
+     * @return The number of temporaries. */
+    std::size_t getTemporaryCount() const noexcept;
+
+    /** Gets the number of variable slots the program needs values for.
+     * @pre None
+     * @post Does not change the program.
+     * @return One more than the largest slot used, or 0 if the program uses no variables. */
+    std::uint32_t getSlotCount() const noexcept;
+
+    /** Gets the table that names the variable slots of the program.
+     * @pre None
+     * @post Does not change the program.
+     * @return The symbol table, or nullptr if the program only uses variables a-f. */
+    const std::shared_ptr<SymbolTable>& getSymbolTable() const noexcept;
+
+    /** Gets the name of a variable slot.
+     * @pre None
+     * @post Does not change the program.
+     * @param slot The slot.
+     * @return The name of the variable. */
+    std::string getVariableName(std::uint32_t slot) const;
+
+    /** Gets whether the instructions form a valid postfix program.
+     * @pre None
+     * @post Does not change the program.
+     * @return Ok, InvalidExpression or UnknownOperator. */
+    EvaluationStatus getStatus() const noexcept;
+
+    /** Gets the deepest evaluation stack of the program.
+     * @pre None
+     * @post Does not change the program.
+     * @return The maximum number of values on the evaluation stack. Meaningless unless getStatus() is Ok. */
+    std::size_t getMaxStackDepth() const noexcept;
+
+    /** Gets the postfix expression the program was compiled from without copying it.
+     * @pre None
+     * @post Does not change the program.
+     * @return A view of the postfix text, valid for the lifetime of the program. */
+    std::string_view getPostfixText() const noexcept;
+
+    /** Gets the number of instructions in the program.
+     * @pre None
+     * @post Does not change the program.
+     * @return The number of instructions. */
+    std::size_t size() const noexcept;
+
+    /** Checks whether the program has no instructions.
+     * @pre None
+     * @post Does not change the program.
+     * @return True if the program is empty, false otherwise. */
+    bool isEmpty() const noexcept;
+
+    /** Gets a view of the program for the interpreter or for writing to a program library.
+     * @pre None
+     * @post Does not change the program.
+     * @return A view of the instructions, constants and postfix text, valid for the lifetime of the program. */
+    PostfixProgramView getView() const noexcept;
+
+    /** Gets a pointer to the first instruction.
+     * @pre None
+     * @post Does not change the program.
+     * @return A pointer to the first instruction of the flat instruction array. */
+    const Instruction* begin() const noexcept;
+
+    /** Gets a pointer past the last instruction.
+     * @pre None
+     * @post Does not change the program.
+     * @return A pointer one past the last instruction of the flat instruction array. */
+    const Instruction* end() const noexcept;
+
+    /** Evaluates the program against a table of the integer values of variables a-f.
+     * @pre variableValues holds SymbolTable::PREDEFINED_COUNT values.
+     * @post Does not change the program, so it can be evaluated again.
+     * @param variableValues The values of variables a-f, indexed by slot.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a variable other than a-f.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const int variableValues[]) const;
+
+    /** Evaluates the program against a table of variable values.
+     * @pre variableValues holds valueCount values.
+     * @post Does not change the program, so it can be evaluated again.
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a slot that has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const double variableValues[], std::size_t valueCount) const;
+
+    /** Evaluates the program against a table of variable values without throwing.
+     * @pre variableValues holds valueCount values.
+     * @post Does not change the program, so it can be evaluated again.
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const double variableValues[], std::size_t valueCount) const;
+
+    /** Evaluates the program over every row of a set of variable columns. Each instruction is run once per block
+     * of BLOCK_SIZE rows instead of once per row, using the fastest SIMD kernels the CPU supports.
+     * @pre results has room for columns.getRowCount() values.
+     * @post Does not change the program or the columns.
+     * @param columns The variable values, one column per variable.
+     * @param results The array that receives one result per row.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs in any row.
+     * @throws std::runtime_error If the program uses a variable that has no column. */
+    void evaluateBatch(const VariableColumns& columns, double results[]) const;
+
+    /** Evaluates the program over every row of a set of variable columns using a given kernel table.
+     * @pre results has room for columns.getRowCount() values.
+     * @post Does not change the program or the columns.
+     * @param columns The variable values, one column per variable.
+     * @param results The array that receives one result per row.
+     * @param kernels The kernels used for the operators.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs in any row.
+     * @throws std::runtime_error If the program uses a variable that has no column. */
+    void evaluateBatch(const VariableColumns& columns, double results[], const BatchKernels::KernelTable& kernels) const;
+
+    /** Evaluates the program over a range of rows of a set of variable columns. Different ranges can be evaluated
+     * concurrently because the program is not changed.
+     * @pre firstRow + rowCount is at most columns.getRowCount(). results has room for rowCount values.
+     * @post Does not change the program or the columns.
+     * @param columns The variable values, one column per variable.
+     * @param firstRow The index of the first row to evaluate.
+     * @param rowCount The number of rows to evaluate.
+     * @param results The array that receives one result per row of the range.
+     * @param kernels The kernels used for the operators.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs in any row.
+     * @throws std::runtime_error If the program uses a variable that has no column.
+     * @throws PrecondViolatedExcept If the range is out of bounds. */
+    void evaluateBatchRange(const VariableColumns& columns, std::size_t firstRow, std::size_t rowCount,
+        double results[], const BatchKernels::KernelTable& kernels) const;
+
+    /** Evaluates the program over every row of a set of variable columns without throwing. Rows that divide by
+     * zero are marked in an error bitmap and the other rows are still evaluated.
+     * @pre None
+     * @post Does not change the program or the columns.
+     * @param columns The variable values, one column per variable.
+     * @return The results and error bitmap, or the status of a program that cannot be evaluated at all. */
+    BatchEvaluationResult tryEvaluateBatch(const VariableColumns& columns) const;
+
+    /** Evaluates the program over every row of a set of variable columns using a given kernel table without
+     * throwing.
+     * @pre None
+     * @post Does not change the program or the columns.
+     * @param columns The variable values, one column per variable.
+     * @param kernels The kernels used for the operators.
+     * @return The results and error bitmap, or the status of a program that cannot be evaluated at all. */
+    BatchEvaluationResult tryEvaluateBatch(const VariableColumns& columns, const BatchKernels::KernelTable& kernels) const;
+}; // end PostfixProgram
+
+#include "PostfixProgram.cpp"
+#endif
@@ -0,0 +1,339 @@
+/** @file PostfixProgramView.cpp
+ * PostfixProgramView evaluates a compiled postfix program in place, wherever its instructions are stored.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "PostfixProgramView.h"
+
+PostfixProgramView::PostfixProgramView() noexcept
+    : instructions(nullptr), instructionCount(0), constants(nullptr), constantCount(0), temporaryCount(0), slotCount(0),
+    status(EvaluationStatus::InvalidExpression), maxStackDepth(0)
+{ } // end default constructor
+
+PostfixProgramView::PostfixProgramView(const Instruction* programInstructions, std::size_t programInstructionCount,
+    const double* programConstants, std::size_t programConstantCount, std::size_t programTemporaryCount,
+    std::uint32_t programSlotCount, std::string_view programPostfixText, EvaluationStatus programStatus,
+    std::size_t programMaxStackDepth) noexcept
+    : instructions(programInstructions), instructionCount(programInstructionCount), constants(programConstants),
+    constantCount(programConstantCount), temporaryCount(programTemporaryCount), slotCount(programSlotCount),
+    status(programStatus), maxStackDepth(programMaxStackDepth), postfixText(programPostfixText)
+{ } // end constructor
+
+std::size_t PostfixProgramView::size() const noexcept
+{
+    return instructionCount;
+} // end size
+
+bool PostfixProgramView::isEmpty() const noexcept
+{
+    return instructionCount == 0;
+} // end isEmpty
+
+const PostfixProgramView::Instruction* PostfixProgramView::begin() const noexcept
+{
+    return instructions;
+} // end begin
+
+const PostfixProgramView::Instruction* PostfixProgramView::end() const noexcept
+{
+    return instructions + instructionCount;
+} // end end
+
+double PostfixProgramView::getConstant(std::size_t index) const noexcept
+{
+    return constants[index];
+} // end getConstant
+
+std::size_t PostfixProgramView::getConstantCount() const noexcept
+{
+    return constantCount;
+} // end getConstantCount
+
+std::size_t PostfixProgramView::getTemporaryCount() const noexcept
+{
+    return temporaryCount;
+} // end getTemporaryCount
+
+std::uint32_t PostfixProgramView::getSlotCount() const noexcept
+{
+    return slotCount;
+} // end getSlotCount
+
+std::string_view PostfixProgramView::getPostfixText() const noexcept
+{
+    return postfixText;
+} // end getPostfixText
+
+EvaluationStatus PostfixProgramView::getStatus() const noexcept
+{
+    return status;
+} // end getStatus
+
+void PostfixProgramView::checkSlotCount(std::size_t valueCount) const
+{
+    if (slotCount > valueCount)  // A view has no names, so slots past a-f are reported by number
+    {
+        std::uint32_t slot = slotCount - 1;
+        throw std::runtime_error("Unknown variable: " +
+            (slot < SymbolTable::PREDEFINED_COUNT ? std::string(1, static_cast<char>('a' + slot)) : "#" + std::to_string(slot)));
+    }
+} // end checkSlotCount
+
+PostfixProgramView::Scratch& PostfixProgramView::getThreadScratch() noexcept
+{
+    thread_local Scratch scratch;  // Evaluation never nests, so one per thread is enough
+    return scratch;
+} // end getThreadScratch
+
+double PostfixProgramView::evaluate(const int variableValues[]) const
+{
+    checkSlotCount(SymbolTable::PREDEFINED_COUNT);
+    return throwIfError(tryEvaluateValues(variableValues, getThreadScratch()));
+} // end evaluate
+
+double PostfixProgramView::evaluate(const double variableValues[], std::size_t valueCount) const
+{
+    checkSlotCount(valueCount);
+    return throwIfError(tryEvaluateValues(variableValues, getThreadScratch()));
+} // end evaluate
+
+double PostfixProgramView::evaluate(const double variableValues[], std::size_t valueCount, Scratch& scratch) const
+{
+    checkSlotCount(valueCount);
+    return throwIfError(tryEvaluateValues(variableValues, scratch));
+} // end evaluate
+
+EvaluationResult PostfixProgramView::tryEvaluate(const double variableValues[], std::size_t valueCount) const
+{
+    return tryEvaluate(variableValues, valueCount, getThreadScratch());
+} // end tryEvaluate
+
+EvaluationResult PostfixProgramView::tryEvaluate(const double variableValues[], std::size_t valueCount,
+    Scratch& scratch) const
+{
+    if (slotCount > valueCount) return { 0, EvaluationStatus::UnknownVariable };
+    return tryEvaluateValues(variableValues, scratch);
+} // end tryEvaluate
+
+double PostfixProgramView::throwIfError(const EvaluationResult& result)
+{
+    if (!result.isOk())
+    {
+        throw std::runtime_error(EvaluationResult::describe(result.status));
+    }
+    return result.value;
+} // end throwIfError
+
+template<class ValueType>
+EvaluationResult PostfixProgramView::tryEvaluateValues(const ValueType variableValues[], Scratch& scratch) const
+{
+    // Structure and depth were found once when the program was compiled, so the loop only checks divisors
+    if (status != EvaluationStatus::Ok) return { 0, status };
+
+    // The stack never grows past maxStackDepth, so it is a plain array: on the call stack for most programs,
+    // otherwise in the scratch storage, and pushes and pops need no bounds checks
+    double inlineStack[INLINE_STACK_DEPTH];
+    double* stackBase = inlineStack;
+    if (maxStackDepth > INLINE_STACK_DEPTH)
+    {
+        if (scratch.stack.size() < maxStackDepth) scratch.stack.resize(maxStackDepth);
+        stackBase = scratch.stack.data();
+    }
+    double* top = stackBase;  // One past the top value
+    std::vector<double>& temporaries = scratch.temporaries;  // Values of common subexpressions, if the program has any
+    if (temporaries.size() < temporaryCount) temporaries.resize(temporaryCount);
+    POSTFIX_STATS(PostfixStatistics::recordEvaluationStackDepth(maxStackDepth));
+
+    // Loop through each instruction without consuming the program
+    for (const Instruction& instruction : *this)
+    {
+        if (instruction.opcode == OpCode::PushVariable)  // Operand
+        {
+            *top++ = variableValues[instruction.operand];
+        }
+        else if (instruction.opcode == OpCode::PushConstant)
+        {
+            *top++ = constants[instruction.operand];
+        }
+        else if (instruction.opcode == OpCode::LoadTemporary)
+        {
+            *top++ = temporaries[instruction.operand];
+        }
+        else if (instruction.opcode == OpCode::StoreTemporary)
+        {
+            temporaries[instruction.operand] = top[-1];
+        }
+        else  // Operator
+        {
+            // Pop the right operand; the left operand is replaced by the result in place
+            double operand2 = *--top;
+            double& operand1 = top[-1];
+
+            // Perform the operation based on the opcode
+            switch (instruction.opcode)
+            {
+            case OpCode::Add: operand1 = operand1 + operand2; break;
+            case OpCode::Subtract: operand1 = operand1 - operand2; break;
+            case OpCode::Multiply: operand1 = operand1 * operand2; break;
+            case OpCode::Divide:
+                if (operand2 == 0) return { 0, EvaluationStatus::DivisionByZero };
+                operand1 = operand1 / operand2;
+                break;
+            default:
+                return { 0, EvaluationStatus::UnknownOperator };
+            }
+        }
+    }
+
+    // A valid program leaves exactly its result on the stack
+    return { stackBase[0], EvaluationStatus::Ok };
+} // end tryEvaluateValues
+
+EvaluationStatus PostfixProgramView::checkStructure(const Instruction programInstructions[], std::size_t count,
+    std::size_t programTemporaryCount, std::size_t& maxDepth)
+{
+    std::size_t depth = 0;
+    maxDepth = 0;
+    std::vector<bool> stored(programTemporaryCount, false);  // Temporaries written so far; others hold stale values
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        OpCode opcode = programInstructions[i].opcode;
+        std::uint32_t operand = programInstructions[i].operand;
+        if (opcode == OpCode::PushVariable || opcode == OpCode::PushConstant || opcode == OpCode::LoadTemporary)
+        {
+            if (opcode == OpCode::LoadTemporary && (operand >= programTemporaryCount || !stored[operand]))
+            {
+                return EvaluationStatus::InvalidExpression;
+            }
+            if (++depth > maxDepth) maxDepth = depth;
+        }
+        else if (opcode == OpCode::StoreTemporary)
+        {
+            if (depth < 1 || operand >= programTemporaryCount) return EvaluationStatus::InvalidExpression;
+            stored[operand] = true;
+        }
+        else
+        {
+            if (depth < 2) return EvaluationStatus::InvalidExpression;
+            if (opcode == OpCode::Unknown) return EvaluationStatus::UnknownOperator;
+            --depth;  // Two operands are replaced by one result
+        }
+    }
+
+    // The final result should be the only value left
+    return depth == 1 ? EvaluationStatus::Ok : EvaluationStatus::InvalidExpression;
+} // end checkStructure
+
+std::size_t PostfixProgramView::getMaxStackDepth() const noexcept
+{
+    return maxStackDepth;
+} // end getMaxStackDepth
+
+void PostfixProgramView::evaluateBatchRange(const VariableColumns& columns, std::size_t firstRow, std::size_t rowCount,
+    double results[], const BatchKernels::KernelTable& kernels) const
+{
+    checkSlotCount(columns.getColumnCount());
+    EvaluationStatus batchStatus = tryEvaluateBatchRange(columns, firstRow, rowCount, results, nullptr, kernels);
+    if (batchStatus != EvaluationStatus::Ok)
+    {
+        throw std::runtime_error(EvaluationResult::describe(batchStatus));
+    }
+} // end evaluateBatchRange
+
+EvaluationStatus PostfixProgramView::tryEvaluateBatchRange(const VariableColumns& columns, std::size_t firstRow,
+    std::size_t rowCount, double results[], std::uint64_t rowErrors[], const BatchKernels::KernelTable& kernels) const
+{
+    if (firstRow > columns.getRowCount() || rowCount > columns.getRowCount() - firstRow)
+    {
+        throw PrecondViolatedExcept("tryEvaluateBatchRange() called with rows outside the columns.");
+    }
+
+    static_assert(BLOCK_SIZE % 64 == 0, "BLOCK_SIZE must fill whole lane mask words");
+
+    // The program was validated when it was compiled; only the columns are checked here
+    if (slotCount > columns.getColumnCount()) return EvaluationStatus::UnknownVariable;
+    if (status != EvaluationStatus::Ok) return status;
+    POSTFIX_STATS(PostfixStatistics::recordEvaluationStackDepth(maxStackDepth));
+    if (rowErrors != nullptr) std::fill(rowErrors, rowErrors + (rowCount + 63) / 64, 0);
+
+    // Each stack entry points at a block of values: a column slice, a constant, a temporary or scratch storage
+    std::vector<double> scratch(maxStackDepth * BLOCK_SIZE);
+    std::vector<const double*> evaluationStack(maxStackDepth);
+    std::vector<double> temporaryBlocks(temporaryCount * BLOCK_SIZE);
+    std::vector<double> constantBlocks(constantCount * BLOCK_SIZE);
+    for (std::size_t i = 0; i < constantCount; ++i)  // Fill each constant block once for the whole batch
+    {
+        std::fill(constantBlocks.begin() + i * BLOCK_SIZE, constantBlocks.begin() + (i + 1) * BLOCK_SIZE, constants[i]);
+    }
+
+    for (std::size_t blockStart = 0; blockStart < rowCount; blockStart += BLOCK_SIZE)
+    {
+        std::size_t blockRows = rowCount - blockStart < BLOCK_SIZE ? rowCount - blockStart : BLOCK_SIZE;
+        std::size_t top = 0;  // Number of blocks on the stack
+
+        for (const Instruction& instruction : *this)
+        {
+            if (instruction.opcode == OpCode::PushVariable)  // Operand block refers to the column directly
+            {
+                evaluationStack[top++] = columns.getColumn(instruction.operand) + firstRow + blockStart;
+                continue;
+            }
+            if (instruction.opcode == OpCode::PushConstant)
+            {
+                evaluationStack[top++] = constantBlocks.data() + instruction.operand * BLOCK_SIZE;
+                continue;
+            }
+            if (instruction.opcode == OpCode::LoadTemporary)
+            {
+                evaluationStack[top++] = temporaryBlocks.data() + instruction.operand * BLOCK_SIZE;
+                continue;
+            }
+            if (instruction.opcode == OpCode::StoreTemporary)  // Copy the block, since scratch blocks are reused
+            {
+                std::copy(evaluationStack[top - 1], evaluationStack[top - 1] + blockRows,
+                    temporaryBlocks.data() + instruction.operand * BLOCK_SIZE);
+                continue;
+            }
+
+            // Operator replaces the top two blocks with a result block in the scratch slot of the left operand
+            --top;
+            const double* operand1 = evaluationStack[top - 1];
+            const double* operand2 = evaluationStack[top];
+            double* result = scratch.data() + (top - 1) * BLOCK_SIZE;
+
+            switch (instruction.opcode)
+            {
+            case OpCode::Add: kernels.add(operand1, operand2, result, blockRows); break;
+            case OpCode::Subtract: kernels.subtract(operand1, operand2, result, blockRows); break;
+            case OpCode::Multiply: kernels.multiply(operand1, operand2, result, blockRows); break;
+            case OpCode::Divide:
+            {
+                // Zero divisors are collected as a lane mask and checked once for the whole block
+                std::uint64_t zeroMask[BLOCK_SIZE / 64] = {};
+                kernels.divide(operand1, operand2, result, blockRows, zeroMask);
+                std::uint64_t anyZero = 0;
+                for (std::size_t word = 0; word < BLOCK_SIZE / 64; ++word)
+                {
+                    anyZero |= zeroMask[word];
+                    if (rowErrors != nullptr && word * 64 < blockRows) rowErrors[blockStart / 64 + word] |= zeroMask[word];
+                }
+                if (anyZero != 0 && rowErrors == nullptr) return EvaluationStatus::DivisionByZero;
+                break;
+            }
+            default:
+                return EvaluationStatus::UnknownOperator;
+            }
+            evaluationStack[top - 1] = result;
+        }
+
+        // Copy the result block of this block of rows
+        const double* finalBlock = evaluationStack[0];
+        for (std::size_t i = 0; i < blockRows; ++i)
+        {
+            results[blockStart + i] = finalBlock[i];
+        }
+    }
+    return EvaluationStatus::Ok;
+} // end tryEvaluateBatchRange
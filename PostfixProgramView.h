@@ -0,0 +1,324 @@
+/** @file PostfixProgramView.h
+ * @class PostfixProgramView
+ * Non-owning view of a compiled postfix program: its instruction array, its constants and its postfix text. The
+ * interpreter runs over views, so a program owned by a PostfixProgram and a program read in place from a memory
+ * mapped MappedProgramLibrary are evaluated by the same code. A view is only valid while the storage it refers to
+ * is alive. The structure of a program is checked once, when it is compiled or loaded, and the view carries the
+ * result and the deepest stack the program reaches, so the tryEvaluate functions report every error as an
+ * EvaluationStatus without throwing, and the interpreter runs on a fixed stack without bounds checks. */
+
+#ifndef POSTFIX_PROGRAM_VIEW_
+#define POSTFIX_PROGRAM_VIEW_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "VariableColumns.h"
+#include "BatchKernels.h"
+#include "PostfixStatistics.h"
+#include "PrecondViolatedExcept.h"
+#include "SymbolTable.h"
+#include "EvaluationResult.h"
+
+class PostfixProgramView
+{
+public:
+    /** Operation codes of the instructions in a compiled program. The values are stored in program libraries, so
+     * new codes must be added before Unknown only together with a new library format version. */
+    enum class OpCode : std::uint8_t
+    {
+        PushVariable,   // Push the value of the variable slot given by the operand
+        PushConstant,   // Push the constant at the index given by the operand
+        Add,            // Pop two values and push their sum
+        Subtract,       // Pop two values and push their difference
+        Multiply,       // Pop two values and push their product
+        Divide,         // Pop two values and push their quotient
+        StoreTemporary, // Copy the top value into the temporary given by the operand, leaving it on the stack
+        LoadTemporary,  // Push the value of the temporary given by the operand
+        Unknown         // Character that is not a valid operator, kept so evaluation reports it
+    };
+
+    /** A single instruction of a compiled program. */
+    struct Instruction
+    {
+        /** The operation to perform. */
+        OpCode opcode;
+
+        /** Variable slot for PushVariable, constant index for PushConstant, temporary index for StoreTemporary and
+         * LoadTemporary, the original character for Unknown, otherwise 0. */
+        std::uint32_t operand;
+    };
+
+    /** Number of rows evaluated together by each operation in batch evaluation. A multiple of 64 so the
+     * division-by-zero lane mask of a block fills whole words. */
+    static constexpr std::size_t BLOCK_SIZE = 256;
+
+    /** Working storage of an evaluation. Reusing one keeps repeated evaluations of programs with common
+     * subexpressions from allocating; each thread needs its own. */
+    struct Scratch
+    {
+        /** Values of common subexpressions. */
+        std::vector<double> temporaries;
+
+        /** Evaluation stack of programs too deep for the stack kept on the call stack. */
+        std::vector<double> stack;
+    };
+
+private:
+    /** Deepest evaluation stack kept on the call stack instead of in the scratch storage. */
+    static constexpr std::size_t INLINE_STACK_DEPTH = 32;
+
+    /** First instruction of the flat instruction array. */
+    const Instruction* instructions;
+
+    /** Number of instructions. */
+    std::size_t instructionCount;
+
+    /** Constants referenced by PushConstant instructions. */
+    const double* constants;
+
+    /** Number of constants. */
+    std::size_t constantCount;
+
+    /** Number of temporaries used by StoreTemporary and LoadTemporary instructions. */
+    std::size_t temporaryCount;
+
+    /** One more than the largest variable slot used. */
+    std::uint32_t slotCount;
+
+    /** Whether the instructions form a valid program, as found by checkStructure. */
+    EvaluationStatus status;
+
+    /** Maximum number of values on the evaluation stack, as found by checkStructure. */
+    std::size_t maxStackDepth;
+
+    /** The postfix expression the program was compiled from. */
+    std::string_view postfixText;
+
+    /** Checks that the program only uses slots that have values.
+     * @pre None
+     * @post None
+     * @param valueCount The number of values available.
+     * @throws std::runtime_error If the program uses a slot of valueCount or more. */
+    void checkSlotCount(std::size_t valueCount) const;
+
+    /** Evaluates the program against a table of values of any arithmetic type.
+     * @pre variableValues holds a value for every slot used by the program.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param scratch The working storage to use.
+     * @return The result of the evaluation, or the reason there is none. */
+    template<class ValueType>
+    EvaluationResult tryEvaluateValues(const ValueType variableValues[], Scratch& scratch) const;
+
+    /** Unwraps the result of an evaluation for the throwing evaluate functions.
+     * @pre None
+     * @post None
+     * @param result The result.
+     * @return The value of the result.
+     * @throws std::runtime_error With the message of the status if the result is not Ok. */
+    static double throwIfError(const EvaluationResult& result);
+
+public:
+    /** Default constructor. Creates a view of an empty program. */
+    PostfixProgramView() noexcept;
+
+    /** Creates a view of a compiled program.
+     * @pre Every operand refers to a valid slot, constant or temporary.
+     * @post The view refers to the given storage without copying it.
+     * @param programInstructions The first instruction.
+     * @param programInstructionCount The number of instructions.
+     * @param programConstants The first constant.
+     * @param programConstantCount The number of constants.
+     * @param programTemporaryCount The number of temporaries the instructions use.
+     * @param programSlotCount One more than the largest variable slot used.
+     * @param programPostfixText The postfix expression the instructions compute.
+     * @param programStatus The result of checkStructure for the instructions.
+     * @param programMaxStackDepth The maximum stack depth found by checkStructure for the instructions. */
+    PostfixProgramView(const Instruction* programInstructions, std::size_t programInstructionCount,
+        const double* programConstants, std::size_t programConstantCount, std::size_t programTemporaryCount,
+        std::uint32_t programSlotCount, std::string_view programPostfixText, EvaluationStatus programStatus,
+        std::size_t programMaxStackDepth) noexcept;
+
+    /** Gets the number of instructions in the program.
+     * @pre None
+     * @post None
+     * @return The number of instructions. */
+    std::size_t size() const noexcept;
+
+    /** Checks whether the program has no instructions.
+     * @pre None
+     * @post None
+     * @return True if the program is empty, false otherwise. */
+    bool isEmpty() const noexcept;
+
+    /** Gets a pointer to the first instruction.
+     * @pre None
+     * @post None
+     * @return A pointer to the first instruction. */
+    const Instruction* begin() const noexcept;
+
+    /** Gets a pointer past the last instruction.
+     * @pre None
+     * @post None
+     * @return A pointer one past the last instruction. */
+    const Instruction* end() const noexcept;
+
+    /** Gets the constant at an index.
+     * @pre index is less than getConstantCount().
+     * @post None
+     * @param index The index of the constant.
+     * @return The constant. */
+    double getConstant(std::size_t index) const noexcept;
+
+    /** Gets the number of constants.
+     * @pre None
+     * @post None
+     * @return The number of constants. */
+    std::size_t getConstantCount() const noexcept;
+
+    /** Gets the number of temporaries used by StoreTemporary and LoadTemporary instructions.
+     * @pre None
+     * @post None
+     * @return The number of temporaries. */
+    std::size_t getTemporaryCount() const noexcept;
+
+    /** Gets the number of variable slots the program needs values for.
+     * @pre None
+     * @post None
+     * @return One more than the largest slot used, or 0 if the program uses no variables. */
+    std::uint32_t getSlotCount() const noexcept;
+
+    /** Gets the postfix expression the program was compiled from.
+     * @pre None
+     * @post None
+     * @return The postfix text. */
+    std::string_view getPostfixText() const noexcept;
+
+    /** Gets whether the instructions form a valid program.
+     * @pre None
+     * @post None
+     * @return Ok, or the error every evaluation of the program reports. */
+    EvaluationStatus getStatus() const noexcept;
+
+    /** Checks that instructions form a well-formed postfix expression and finds their deepest stack.
+     * @pre None
+     * @post None
+     * @param programInstructions The first instruction.
+     * @param count The number of instructions.
+     * @param programTemporaryCount The number of temporaries the instructions may use.
+     * @param maxDepth Receives the maximum number of values on the evaluation stack.
+     * @return Ok, InvalidExpression if an operator lacks operands, more than one value is left or a temporary is
+     * loaded before it is stored, or UnknownOperator.
+     * @throws std::bad_alloc If the record of stored temporaries cannot be allocated. */
+    static EvaluationStatus checkStructure(const Instruction programInstructions[], std::size_t count,
+        std::size_t programTemporaryCount, std::size_t& maxDepth);
+
+    /** Gets the deepest evaluation stack of the program, found when it was compiled.
+     * @pre None
+     * @post None
+     * @return The maximum number of values on the evaluation stack. Meaningless unless getStatus() is Ok. */
+    std::size_t getMaxStackDepth() const noexcept;
+
+    /** Gets the working storage of the calling thread. The evaluation functions that take no scratch use it, so
+     * they stop allocating once it has grown to fit the largest program the thread evaluates.
+     * @pre None
+     * @post None
+     * @return The scratch storage of the calling thread. */
+    static Scratch& getThreadScratch() noexcept;
+
+    /** Evaluates the program against a table of the integer values of variables a-f.
+     * @pre variableValues holds six values.
+     * @post None
+     * @param variableValues The values of variables a-f, indexed by slot.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a variable other than a-f.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const int variableValues[]) const;
+
+    /** Evaluates the program against a table of variable values.
+     * @pre variableValues holds valueCount values.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a slot that has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const double variableValues[], std::size_t valueCount) const;
+
+    /** Evaluates the program against a table of variable values using caller-owned working storage.
+     * @pre variableValues holds valueCount values. scratch is not used by another thread at the same time.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @param scratch The working storage, reused between evaluations.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a slot that has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const double variableValues[], std::size_t valueCount, Scratch& scratch) const;
+
+    /** Evaluates the program against a table of variable values without throwing.
+     * @pre variableValues holds valueCount values.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const double variableValues[], std::size_t valueCount) const;
+
+    /** Evaluates the program against a table of variable values using caller-owned working storage without
+     * throwing.
+     * @pre variableValues holds valueCount values. scratch is not used by another thread at the same time.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @param scratch The working storage, reused between evaluations.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const double variableValues[], std::size_t valueCount, Scratch& scratch) const;
+
+    /** Evaluates the program over a range of rows of a set of variable columns, running each instruction once per
+     * block of BLOCK_SIZE rows. Different ranges can be evaluated concurrently.
+     * @pre firstRow + rowCount is at most columns.getRowCount(). results has room for rowCount values.
+     * @post None
+     * @param columns The variable values, one column per variable.
+     * @param firstRow The index of the first row to evaluate.
+     * @param rowCount The number of rows to evaluate.
+     * @param results The array that receives one result per row of the range.
+     * @param kernels The kernels used for the operators.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs in any row.
+     * @throws std::runtime_error If the program uses a variable that has no column.
+     * @throws PrecondViolatedExcept If the range is out of bounds. */
+    void evaluateBatchRange(const VariableColumns& columns, std::size_t firstRow, std::size_t rowCount,
+        double results[], const BatchKernels::KernelTable& kernels) const;
+
+    /** Evaluates the program over a range of rows like evaluateBatchRange, reporting errors instead of throwing.
+     * With an error bitmap, rows that divide by zero are marked in it and the other rows are still evaluated.
+     * @pre firstRow + rowCount is at most columns.getRowCount(). results has room for rowCount values. rowErrors
+     * is nullptr or has room for (rowCount + 63) / 64 words.
+     * @post Bit r % 64 of rowErrors[r / 64] is set if and only if row firstRow + r divided by zero.
+     * @param columns The variable values, one column per variable.
+     * @param firstRow The index of the first row to evaluate.
+     * @param rowCount The number of rows to evaluate.
+     * @param results The array that receives one result per row of the range.
+     * @param rowErrors The bitmap that receives the rows that divided by zero, or nullptr to stop at the first.
+     * @param kernels The kernels used for the operators.
+     * @return Ok, or UnknownVariable, InvalidExpression or UnknownOperator for the whole range, or DivisionByZero
+     * if rowErrors is nullptr and a row divided by zero.
+     * @throws PrecondViolatedExcept If the range is out of bounds. */
+    EvaluationStatus tryEvaluateBatchRange(const VariableColumns& columns, std::size_t firstRow, std::size_t rowCount,
+        double results[], std::uint64_t rowErrors[], const BatchKernels::KernelTable& kernels) const;
+}; // end PostfixProgramView
+
+#include "PostfixProgramView.cpp"
+#endif
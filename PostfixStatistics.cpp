@@ -0,0 +1,133 @@
+/** @file PostfixStatistics.cpp
+ * PostfixStatistics keeps relaxed atomic counters that are cheap enough to update on every call.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "PostfixStatistics.h"
+
+PostfixStatistics::PhaseTimer::PhaseTimer(Phase phase) noexcept
+    : timedPhase(phase), start(std::chrono::steady_clock::now())
+{ } // end constructor
+
+PostfixStatistics::PhaseTimer::~PhaseTimer()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    recordPhase(timedPhase, static_cast<std::uint64_t>(elapsed.count()));
+} // end destructor
+
+void PostfixStatistics::raiseTo(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+{
+    std::uint64_t current = counter.load(std::memory_order_relaxed);
+    while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+        // current was reloaded by the failed exchange
+    }
+} // end raiseTo
+
+void PostfixStatistics::recordPhase(Phase phase, std::uint64_t nanoseconds) noexcept
+{
+    PhaseCounters& counters = phaseCounters[static_cast<std::size_t>(phase)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    raiseTo(counters.maxNanoseconds, nanoseconds);
+} // end recordPhase
+
+void PostfixStatistics::recordNodeAllocation() noexcept
+{
+    nodeAllocationCount.fetch_add(1, std::memory_order_relaxed);
+} // end recordNodeAllocation
+
+void PostfixStatistics::recordOperatorStackDepth(std::size_t depth) noexcept
+{
+    raiseTo(peakOperatorDepth, depth);
+} // end recordOperatorStackDepth
+
+void PostfixStatistics::recordEvaluationStackDepth(std::size_t depth) noexcept
+{
+    raiseTo(peakEvaluationDepth, depth);
+} // end recordEvaluationStackDepth
+
+void PostfixStatistics::recordException(const std::exception& error) noexcept
+{
+    ErrorKind kind = ErrorKind::Other;
+    if (std::strcmp(error.what(), "Invalid postfix expression") == 0) kind = ErrorKind::InvalidExpression;
+    else if (std::strcmp(error.what(), "Division by zero") == 0) kind = ErrorKind::DivisionByZero;
+    else if (std::strcmp(error.what(), "Unknown operator encountered") == 0) kind = ErrorKind::UnknownOperator;
+
+    exceptionCounts[static_cast<std::size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+} // end recordException
+
+template<class Function>
+decltype(auto) PostfixStatistics::countExceptions(Function&& function)
+{
+#ifdef POSTFIX_ENABLE_STATS
+    try
+    {
+        return function();
+    }
+    catch (const std::exception& error)
+    {
+        recordException(error);
+        throw;
+    }
+#else
+    return function();
+#endif
+} // end countExceptions
+
+PostfixStatistics::Snapshot PostfixStatistics::getSnapshot() noexcept
+{
+    Snapshot snapshot = {};
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Phase::Count); ++i)
+    {
+        snapshot.phases[i].calls = phaseCounters[i].calls.load(std::memory_order_relaxed);
+        snapshot.phases[i].totalNanoseconds = phaseCounters[i].totalNanoseconds.load(std::memory_order_relaxed);
+        snapshot.phases[i].maxNanoseconds = phaseCounters[i].maxNanoseconds.load(std::memory_order_relaxed);
+    }
+    snapshot.nodeAllocations = nodeAllocationCount.load(std::memory_order_relaxed);
+    snapshot.peakOperatorStackDepth = peakOperatorDepth.load(std::memory_order_relaxed);
+    snapshot.peakEvaluationStackDepth = peakEvaluationDepth.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(ErrorKind::Count); ++i)
+    {
+        snapshot.exceptions[i] = exceptionCounts[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+} // end getSnapshot
+
+void PostfixStatistics::reset() noexcept
+{
+    for (PhaseCounters& counters : phaseCounters)
+    {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.totalNanoseconds.store(0, std::memory_order_relaxed);
+        counters.maxNanoseconds.store(0, std::memory_order_relaxed);
+    }
+    nodeAllocationCount.store(0, std::memory_order_relaxed);
+    peakOperatorDepth.store(0, std::memory_order_relaxed);
+    peakEvaluationDepth.store(0, std::memory_order_relaxed);
+    for (std::atomic<std::uint64_t>& count : exceptionCounts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+} // end reset
+
+void PostfixStatistics::writeSnapshot(const Snapshot& snapshot, std::ostream& output)
+{
+    static const char* const phaseNames[] = { "convert", "evaluate", "stringify" };
+    static const char* const errorNames[] = { "invalid_expression", "division_by_zero", "unknown_operator", "other" };
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Phase::Count); ++i)
+    {
+        output << "postfix_" << phaseNames[i] << "_calls " << snapshot.phases[i].calls << '\n';
+        output << "postfix_" << phaseNames[i] << "_total_ns " << snapshot.phases[i].totalNanoseconds << '\n';
+        output << "postfix_" << phaseNames[i] << "_max_ns " << snapshot.phases[i].maxNanoseconds << '\n';
+    }
+    output << "postfix_node_allocations " << snapshot.nodeAllocations << '\n';
+    output << "postfix_peak_operator_stack_depth " << snapshot.peakOperatorStackDepth << '\n';
+    output << "postfix_peak_evaluation_stack_depth " << snapshot.peakEvaluationStackDepth << '\n';
+    for (std::size_t i = 0; i < static_cast<std::size_t>(ErrorKind::Count); ++i)
+    {
+        output << "postfix_exceptions_" << errorNames[i] << ' ' << snapshot.exceptions[i] << '\n';
+    }
+} // end writeSnapshot
@@ -0,0 +1,171 @@
+/** @file PostfixStatistics.h
+ * @class PostfixStatistics
+ * Process-wide counters for the hot paths of conversion and evaluation: time spent per phase, LinkedStack node
+ * allocations, peak operator and evaluation stack depths, and exceptions thrown by kind. Counters are only updated
+ * when the project is compiled with POSTFIX_ENABLE_STATS defined. Otherwise every POSTFIX_STATS statement compiles
+ * to nothing and snapshots are all zero. Counters are atomic, so they can be read while other threads evaluate. */
+
+#ifndef POSTFIX_STATISTICS_
+#define POSTFIX_STATISTICS_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+#ifdef POSTFIX_ENABLE_STATS
+#define POSTFIX_STATS(statement) statement
+#else
+#define POSTFIX_STATS(statement)
+#endif
+
+class PostfixStatistics
+{
+public:
+    /** Phases that are timed. */
+    enum class Phase : std::uint8_t
+    {
+        Convert,    // convertInfixToPostfix
+        Evaluate,   // evaluatePostfixExpression and evaluatePostfixExpressionBatch
+        Stringify,  // getPostfixExpression
+        Count       // Number of phases
+    };
+
+    /** Kinds of exceptions that are counted. */
+    enum class ErrorKind : std::uint8_t
+    {
+        InvalidExpression,
+        DivisionByZero,
+        UnknownOperator,
+        Other,
+        Count  // Number of kinds
+    };
+
+    /** Totals for one phase. */
+    struct PhaseSnapshot
+    {
+        std::uint64_t calls;
+        std::uint64_t totalNanoseconds;
+        std::uint64_t maxNanoseconds;
+    };
+
+    /** Copy of every counter at one point in time. */
+    struct Snapshot
+    {
+        PhaseSnapshot phases[static_cast<std::size_t>(Phase::Count)];
+        std::uint64_t nodeAllocations;
+        std::uint64_t peakOperatorStackDepth;
+        std::uint64_t peakEvaluationStackDepth;
+        std::uint64_t exceptions[static_cast<std::size_t>(ErrorKind::Count)];
+    };
+
+    /** Times one call of a phase from construction to destruction. */
+    class PhaseTimer
+    {
+    private:
+        Phase timedPhase;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        /** Starts timing a phase.
+         * @param phase The phase being timed. */
+        explicit PhaseTimer(Phase phase) noexcept;
+
+        /** Adds the elapsed time to the phase. */
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+    };
+
+    /** True if the project was compiled with POSTFIX_ENABLE_STATS. */
+#ifdef POSTFIX_ENABLE_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+private:
+    /** Live counters for one phase. Only used for static storage, which starts zeroed. */
+    struct PhaseCounters
+    {
+        std::atomic<std::uint64_t> calls;
+        std::atomic<std::uint64_t> totalNanoseconds;
+        std::atomic<std::uint64_t> maxNanoseconds;
+    };
+
+    inline static PhaseCounters phaseCounters[static_cast<std::size_t>(Phase::Count)];
+    inline static std::atomic<std::uint64_t> nodeAllocationCount{ 0 };
+    inline static std::atomic<std::uint64_t> peakOperatorDepth{ 0 };
+    inline static std::atomic<std::uint64_t> peakEvaluationDepth{ 0 };
+    inline static std::atomic<std::uint64_t> exceptionCounts[static_cast<std::size_t>(ErrorKind::Count)];
+
+    /** Raises a counter to a value if the value is larger.
+     * @param counter The counter to raise.
+     * @param value The candidate value. */
+    static void raiseTo(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept;
+
+public:
+    /** Adds one call of a phase.
+     * @pre None
+     * @post The phase totals include the call.
+     * @param phase The phase.
+     * @param nanoseconds The duration of the call. */
+    static void recordPhase(Phase phase, std::uint64_t nanoseconds) noexcept;
+
+    /** Counts one LinkedStack node allocation.
+     * @pre None
+     * @post The allocation count is one larger. */
+    static void recordNodeAllocation() noexcept;
+
+    /** Records the depth of the operator stack during conversion.
+     * @pre None
+     * @post The peak operator stack depth is at least depth.
+     * @param depth The current depth. */
+    static void recordOperatorStackDepth(std::size_t depth) noexcept;
+
+    /** Records the deepest evaluation stack of one evaluation.
+     * @pre None
+     * @post The peak evaluation stack depth is at least depth.
+     * @param depth The deepest stack of the evaluation. */
+    static void recordEvaluationStackDepth(std::size_t depth) noexcept;
+
+    /** Counts an exception, classified by its message.
+     * @pre None
+     * @post The count of the matching kind is one larger.
+     * @param error The exception that was thrown. */
+    static void recordException(const std::exception& error) noexcept;
+
+    /** Calls a function and counts the exception it throws, if any, before passing it on. Without
+     * POSTFIX_ENABLE_STATS the function is simply called.
+     * @pre None
+     * @post Any exception thrown by function is counted and rethrown.
+     * @param function The function to call.
+     * @return The result of the function. */
+    template<class Function>
+    static decltype(auto) countExceptions(Function&& function);
+
+    /** Copies every counter.
+     * @pre None
+     * @post None
+     * @return The current counters. */
+    static Snapshot getSnapshot() noexcept;
+
+    /** Sets every counter back to zero.
+     * @pre None
+     * @post Every counter is zero. */
+    static void reset() noexcept;
+
+    /** Writes a snapshot as "name value" lines that monitoring tools can scrape.
+     * @pre None
+     * @post The snapshot is written to output.
+     * @param snapshot The counters to write.
+     * @param output The stream to write to. */
+    static void writeSnapshot(const Snapshot& snapshot, std::ostream& output);
+}; // end PostfixStatistics
+
+#include "PostfixStatistics.cpp"
+#endif
@@ -0,0 +1,251 @@
+/** @file RegisterProgram.cpp
+ * RegisterProgram lowers a postfix program into three-address register instructions and evaluates them.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "RegisterProgram.h"
+
+RegisterProgram::RegisterProgram()
+    : registerCount(0), temporaryBase(0), temporaryCount(0), resultRegister(0), slotCount(0),
+    status(EvaluationStatus::InvalidExpression)
+{ } // end default constructor
+
+RegisterProgram::RegisterProgram(const PostfixProgramView& program)
+    : registerCount(0), temporaryBase(0), temporaryCount(0), resultRegister(0), slotCount(program.getSlotCount()),
+    status(program.getStatus())
+{
+    if (status != EvaluationStatus::Ok) return;  // Nothing to lower; every evaluation reports the status
+
+    constexpr std::uint32_t NO_REGISTER = UINT32_MAX;
+    using StackOpCode = PostfixProgramView::OpCode;
+
+    // Registers: constants first, then one per variable used, then temporaries, then one per stack position
+    constants.assign(program.getConstantCount(), 0);
+    for (std::size_t i = 0; i < constants.size(); ++i)
+    {
+        constants[i] = program.getConstant(i);
+    }
+    std::vector<std::uint32_t> slotRegisters(slotCount, NO_REGISTER);
+    std::uint32_t nextRegister = static_cast<std::uint32_t>(constants.size());
+    for (const PostfixProgramView::Instruction& instruction : program)
+    {
+        if (instruction.opcode == StackOpCode::PushVariable && slotRegisters[instruction.operand] == NO_REGISTER)
+        {
+            slotRegisters[instruction.operand] = nextRegister;
+            variableLoads.push_back({ nextRegister++, instruction.operand });
+        }
+    }
+    temporaryBase = nextRegister;
+    temporaryCount = program.getTemporaryCount();
+    std::uint32_t stackBase = temporaryBase + static_cast<std::uint32_t>(temporaryCount);
+    registerCount = stackBase + program.getMaxStackDepth();
+
+    // Simulate the stack with the register holding each position, so operands are named instead of pushed
+    std::vector<std::uint32_t> temporaryRegisters(temporaryCount);
+    for (std::size_t i = 0; i < temporaryRegisters.size(); ++i)
+    {
+        temporaryRegisters[i] = temporaryBase + static_cast<std::uint32_t>(i);
+    }
+    std::vector<std::uint32_t> operandRegisters;
+    operandRegisters.reserve(program.getMaxStackDepth());
+    instructions.reserve(program.size() + 1);
+
+    for (const PostfixProgramView::Instruction& instruction : program)
+    {
+        switch (instruction.opcode)
+        {
+        case StackOpCode::PushVariable: operandRegisters.push_back(slotRegisters[instruction.operand]); break;
+        case StackOpCode::PushConstant: operandRegisters.push_back(instruction.operand); break;
+        case StackOpCode::LoadTemporary: operandRegisters.push_back(temporaryRegisters[instruction.operand]); break;
+        case StackOpCode::StoreTemporary:
+        {
+            std::uint32_t source = operandRegisters.back();
+            if (source < temporaryBase)  // A constant or variable never changes, so the temporary names its register
+            {
+                temporaryRegisters[instruction.operand] = source;
+                break;
+            }
+
+            // Other registers are overwritten later, so copy the value. Pending loads of the old value keep a copy.
+            std::uint32_t temporary = temporaryBase + instruction.operand;
+            for (std::size_t position = 0; position < operandRegisters.size(); ++position)
+            {
+                if (operandRegisters[position] == temporary)
+                {
+                    std::uint32_t positionRegister = stackBase + static_cast<std::uint32_t>(position);
+                    instructions.push_back({ OpCode::Move, positionRegister, temporary, 0 });
+                    operandRegisters[position] = positionRegister;
+                }
+            }
+            instructions.push_back({ OpCode::Move, temporary, source, 0 });
+            temporaryRegisters[instruction.operand] = temporary;
+            break;
+        }
+        default:  // Operator: the result takes the stack position of the left operand
+        {
+            std::uint32_t right = operandRegisters.back();
+            operandRegisters.pop_back();
+            std::uint32_t left = operandRegisters.back();
+            std::uint32_t destination = stackBase + static_cast<std::uint32_t>(operandRegisters.size() - 1);
+            OpCode opcode = OpCode::Add;
+            if (instruction.opcode == StackOpCode::Subtract) opcode = OpCode::Subtract;
+            else if (instruction.opcode == StackOpCode::Multiply) opcode = OpCode::Multiply;
+            else if (instruction.opcode == StackOpCode::Divide) opcode = OpCode::Divide;
+            instructions.push_back({ opcode, destination, left, right });
+            operandRegisters.back() = destination;
+            break;
+        }
+        }
+    }
+
+    resultRegister = operandRegisters.back();  // A valid program leaves exactly its result
+    instructions.push_back({ OpCode::Return, 0, 0, 0 });
+} // end constructor
+
+std::size_t RegisterProgram::size() const noexcept
+{
+    return instructions.size();
+} // end size
+
+const RegisterProgram::Instruction* RegisterProgram::begin() const noexcept
+{
+    return instructions.data();
+} // end begin
+
+const RegisterProgram::Instruction* RegisterProgram::end() const noexcept
+{
+    return instructions.data() + instructions.size();
+} // end end
+
+const std::vector<RegisterProgram::VariableLoad>& RegisterProgram::getVariableLoads() const noexcept
+{
+    return variableLoads;
+} // end getVariableLoads
+
+std::size_t RegisterProgram::getRegisterCount() const noexcept
+{
+    return registerCount;
+} // end getRegisterCount
+
+std::uint32_t RegisterProgram::getSlotCount() const noexcept
+{
+    return slotCount;
+} // end getSlotCount
+
+EvaluationStatus RegisterProgram::getStatus() const noexcept
+{
+    return status;
+} // end getStatus
+
+#ifdef POSTFIX_COMPUTED_GOTO
+// Labels as values are a GNU extension, chosen on purpose; keep -Wpedantic builds quiet about them
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+EvaluationResult RegisterProgram::run(double registers[]) const noexcept
+{
+    const Instruction* instruction = instructions.data();
+
+#ifdef POSTFIX_COMPUTED_GOTO
+    // Each handler jumps straight to the next one, so every instruction has its own indirect branch to predict
+    static const void* const dispatchTable[] = { &&add, &&subtract, &&multiply, &&divide, &&move, &&finish };
+#define POSTFIX_DISPATCH() goto *dispatchTable[static_cast<std::size_t>(instruction->opcode)]
+
+    POSTFIX_DISPATCH();
+add:
+    registers[instruction->destination] = registers[instruction->left] + registers[instruction->right];
+    ++instruction;
+    POSTFIX_DISPATCH();
+subtract:
+    registers[instruction->destination] = registers[instruction->left] - registers[instruction->right];
+    ++instruction;
+    POSTFIX_DISPATCH();
+multiply:
+    registers[instruction->destination] = registers[instruction->left] * registers[instruction->right];
+    ++instruction;
+    POSTFIX_DISPATCH();
+divide:
+    if (registers[instruction->right] == 0) return { 0, EvaluationStatus::DivisionByZero };
+    registers[instruction->destination] = registers[instruction->left] / registers[instruction->right];
+    ++instruction;
+    POSTFIX_DISPATCH();
+move:
+    registers[instruction->destination] = registers[instruction->left];
+    ++instruction;
+    POSTFIX_DISPATCH();
+finish:
+    return { registers[resultRegister], EvaluationStatus::Ok };
+
+#undef POSTFIX_DISPATCH
+#else
+    for (;; ++instruction)
+    {
+        switch (instruction->opcode)
+        {
+        case OpCode::Add:
+            registers[instruction->destination] = registers[instruction->left] + registers[instruction->right];
+            break;
+        case OpCode::Subtract:
+            registers[instruction->destination] = registers[instruction->left] - registers[instruction->right];
+            break;
+        case OpCode::Multiply:
+            registers[instruction->destination] = registers[instruction->left] * registers[instruction->right];
+            break;
+        case OpCode::Divide:
+            if (registers[instruction->right] == 0) return { 0, EvaluationStatus::DivisionByZero };
+            registers[instruction->destination] = registers[instruction->left] / registers[instruction->right];
+            break;
+        case OpCode::Move:
+            registers[instruction->destination] = registers[instruction->left];
+            break;
+        case OpCode::Return:
+            return { registers[resultRegister], EvaluationStatus::Ok };
+        }
+    }
+#endif
+} // end run
+#ifdef POSTFIX_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+EvaluationResult RegisterProgram::tryEvaluate(const double variableValues[], std::size_t valueCount,
+    PostfixProgramView::Scratch& scratch) const
+{
+    if (slotCount > valueCount) return { 0, EvaluationStatus::UnknownVariable };
+    if (status != EvaluationStatus::Ok) return { 0, status };
+
+    double inlineRegisters[INLINE_REGISTER_COUNT];
+    double* registers = inlineRegisters;
+    if (registerCount > INLINE_REGISTER_COUNT)
+    {
+        if (scratch.stack.size() < registerCount) scratch.stack.resize(registerCount);
+        registers = scratch.stack.data();
+    }
+
+    // Load constants and variables once; the instructions then only read and write registers
+    std::copy(constants.begin(), constants.end(), registers);
+    std::fill(registers + temporaryBase, registers + temporaryBase + temporaryCount, 0);  // As if never stored
+    for (const VariableLoad& load : variableLoads)
+    {
+        registers[load.destination] = variableValues[load.slot];
+    }
+    return run(registers);
+} // end tryEvaluate
+
+double RegisterProgram::evaluate(const double variableValues[], std::size_t valueCount) const
+{
+    if (slotCount > valueCount)  // Slots past a-f are reported by number, as by PostfixProgramView
+    {
+        std::uint32_t slot = slotCount - 1;
+        throw std::runtime_error("Unknown variable: " +
+            (slot < SymbolTable::PREDEFINED_COUNT ? std::string(1, static_cast<char>('a' + slot)) : "#" + std::to_string(slot)));
+    }
+
+    EvaluationResult result = tryEvaluate(variableValues, valueCount, PostfixProgramView::getThreadScratch());
+    if (!result.isOk())
+    {
+        throw std::runtime_error(EvaluationResult::describe(result.status));
+    }
+    return result.value;
+} // end evaluate
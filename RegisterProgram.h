@@ -0,0 +1,181 @@
+/** @file RegisterProgram.h
+ * @class RegisterProgram
+ * Register-based form of a compiled postfix program, an alternative backend to the stack interpreter of
+ * PostfixProgramView. Lowering gives every constant, every variable the program uses, every temporary and every
+ * stack position a register of its own, and turns each operator into one three-address instruction such as
+ * r7 = r2 * r5. Operands are never pushed or popped: variables are copied into their registers once before the
+ * instructions run, and constants and temporaries are read where they are. Instructions are dispatched with
+ * computed goto on compilers that support it (GCC and Clang) and with a switch elsewhere. */
+
+#ifndef REGISTER_PROGRAM_
+#define REGISTER_PROGRAM_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PostfixProgramView.h"
+#include "EvaluationResult.h"
+
+#if defined(__GNUC__) && !defined(POSTFIX_NO_COMPUTED_GOTO)
+#define POSTFIX_COMPUTED_GOTO 1
+#endif
+
+class RegisterProgram
+{
+public:
+    /** Operation codes of register instructions. The order matches the dispatch table of the interpreter. */
+    enum class OpCode : std::uint8_t
+    {
+        Add,       // destination = left + right
+        Subtract,  // destination = left - right
+        Multiply,  // destination = left * right
+        Divide,    // destination = left / right, stopping if right is 0
+        Move,      // destination = left, keeping a stack value as a temporary
+        Return     // Stop; the result is in the result register
+    };
+
+    /** A three-address instruction. Every operand is a register index. */
+    struct Instruction
+    {
+        /** The operation to perform. */
+        OpCode opcode;
+
+        /** The register that receives the result. */
+        std::uint32_t destination;
+
+        /** The left operand, or the source of a Move. */
+        std::uint32_t left;
+
+        /** The right operand. */
+        std::uint32_t right;
+    };
+
+    /** A variable copied into a register before the instructions run. */
+    struct VariableLoad
+    {
+        /** The register of the variable. */
+        std::uint32_t destination;
+
+        /** The slot of the variable in the table of values. */
+        std::uint32_t slot;
+    };
+
+private:
+    /** Largest register file kept on the call stack instead of in the scratch storage. */
+    static constexpr std::size_t INLINE_REGISTER_COUNT = 64;
+
+    /** The instructions, ending with Return. */
+    std::vector<Instruction> instructions;
+
+    /** The variables to copy into registers, one per variable the program uses. */
+    std::vector<VariableLoad> variableLoads;
+
+    /** The constants, which take the first registers. */
+    std::vector<double> constants;
+
+    /** Number of registers the instructions use. */
+    std::size_t registerCount;
+
+    /** First register of the temporaries, which follow the variables. */
+    std::uint32_t temporaryBase;
+
+    /** Number of temporaries. */
+    std::size_t temporaryCount;
+
+    /** The register that holds the result after Return. */
+    std::uint32_t resultRegister;
+
+    /** One more than the largest variable slot used. */
+    std::uint32_t slotCount;
+
+    /** Whether the source program is valid. Invalid programs are not lowered and report this status. */
+    EvaluationStatus status;
+
+    /** Runs the instructions on a register file whose constants and variables are loaded.
+     * @pre registers holds registerCount values.
+     * @post None
+     * @param registers The register file.
+     * @return The result, or DivisionByZero. */
+    EvaluationResult run(double registers[]) const noexcept;
+
+public:
+    /** Default constructor. Creates an empty, invalid program. */
+    RegisterProgram();
+
+    /** Lowers a stack program into registers.
+     * @pre Every operand of the program refers to a valid slot, constant or temporary.
+     * @post The register program computes the same results as the stack program, including its errors.
+     * @param program The program to lower.
+     * @throws std::bad_alloc If the instructions cannot be allocated. */
+    explicit RegisterProgram(const PostfixProgramView& program);
+
+    /** Gets the number of instructions, including the final Return.
+     * @pre None
+     * @post None
+     * @return The number of instructions. */
+    std::size_t size() const noexcept;
+
+    /** Gets a pointer to the first instruction.
+     * @pre None
+     * @post None
+     * @return A pointer to the first instruction. */
+    const Instruction* begin() const noexcept;
+
+    /** Gets a pointer past the last instruction.
+     * @pre None
+     * @post None
+     * @return A pointer one past the last instruction. */
+    const Instruction* end() const noexcept;
+
+    /** Gets the variables copied into registers before the instructions run.
+     * @pre None
+     * @post None
+     * @return One load per variable the program uses. */
+    const std::vector<VariableLoad>& getVariableLoads() const noexcept;
+
+    /** Gets the number of registers the program uses.
+     * @pre None
+     * @post None
+     * @return The number of registers. */
+    std::size_t getRegisterCount() const noexcept;
+
+    /** Gets the number of variable slots the program needs values for.
+     * @pre None
+     * @post None
+     * @return One more than the largest slot used, or 0 if the program uses no variables. */
+    std::uint32_t getSlotCount() const noexcept;
+
+    /** Gets whether the source program was valid.
+     * @pre None
+     * @post None
+     * @return Ok, or the error every evaluation of the program reports. */
+    EvaluationStatus getStatus() const noexcept;
+
+    /** Evaluates the program against a table of variable values without throwing.
+     * @pre variableValues holds valueCount values. scratch is not used by another thread at the same time.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @param scratch The working storage, used for programs with many registers.
+     * @return The result, or UnknownVariable, InvalidExpression, UnknownOperator or DivisionByZero. */
+    EvaluationResult tryEvaluate(const double variableValues[], std::size_t valueCount,
+        PostfixProgramView::Scratch& scratch) const;
+
+    /** Evaluates the program against a table of variable values.
+     * @pre variableValues holds valueCount values.
+     * @post None
+     * @param variableValues The values of the variables, indexed by slot.
+     * @param valueCount The number of values.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If the program uses a slot that has no value.
+     * @throws std::runtime_error If the program is not a valid postfix expression.
+     * @throws std::runtime_error If an unknown operator is encountered.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const double variableValues[], std::size_t valueCount) const;
+}; // end RegisterProgram
+
+#include "RegisterProgram.cpp"
+#endif
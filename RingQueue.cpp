@@ -0,0 +1,179 @@
+/** @file RingQueue.cpp
+ * RingQueue implements a queue using a contiguous ring buffer that grows when full.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "RingQueue.h"
+
+// Default constructor. Initializes an empty queue with a small ring buffer.
+template<class ItemType>
+RingQueue<ItemType>::RingQueue()
+    : items(new ItemType[INITIAL_CAPACITY]), frontIndex(0), itemCount(0), capacity(INITIAL_CAPACITY)
+{ } // end default constructor
+
+// Copy constructor that copies the items of the original queue in order.
+template<class ItemType>
+RingQueue<ItemType>::RingQueue(const RingQueue<ItemType>& originalQueue)
+    : items(new ItemType[originalQueue.capacity]), frontIndex(0), itemCount(originalQueue.itemCount),
+    capacity(originalQueue.capacity)
+{
+    for (std::size_t i = 0; i < itemCount; ++i)
+    {
+        items[i] = originalQueue[i];
+    }
+} // end copy constructor
+
+// Copy assignment that replaces the items with copies of the original queue's items.
+template<class ItemType>
+RingQueue<ItemType>& RingQueue<ItemType>::operator=(const RingQueue<ItemType>& originalQueue)
+{
+    if (this != &originalQueue)
+    {
+        RingQueue<ItemType> copy(originalQueue);
+        items.swap(copy.items);
+        frontIndex = copy.frontIndex;
+        itemCount = copy.itemCount;
+        capacity = copy.capacity;
+    }
+    return *this;
+} // end operator=
+
+// Destructor. The ring buffer is released by its smart pointer.
+template<class ItemType>
+RingQueue<ItemType>::~RingQueue()
+{ } // end destructor
+
+// Doubles the capacity and unwraps the items to the start of the new buffer.
+template<class ItemType>
+void RingQueue<ItemType>::grow()
+{
+    std::size_t newCapacity = capacity * 2;
+    std::unique_ptr<ItemType[]> newItems(new ItemType[newCapacity]);
+
+    for (std::size_t i = 0; i < itemCount; ++i)
+    {
+        newItems[i] = (*this)[i];
+    }
+
+    items = std::move(newItems);
+    frontIndex = 0;
+    capacity = newCapacity;
+} // end grow
+
+// Checks if the queue is empty.
+template<class ItemType>
+bool RingQueue<ItemType>::isEmpty() const noexcept
+{
+    return itemCount == 0;
+} // end isEmpty
+
+// Adds a new entry to the back of the queue.
+template<class ItemType>
+bool RingQueue<ItemType>::enqueue(const ItemType& someItem) noexcept
+{
+    if (itemCount == capacity)
+    {
+        try
+        {
+            grow();
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;  // Queue is unchanged
+        }
+    }
+
+    items[(frontIndex + itemCount) & (capacity - 1)] = someItem;
+    ++itemCount;
+    return true;
+} // end enqueue
+
+// Removes the item at the front of the queue.
+template<class ItemType>
+bool RingQueue<ItemType>::dequeue() noexcept
+{
+    if (!isEmpty())
+    {
+        frontIndex = (frontIndex + 1) & (capacity - 1);
+        --itemCount;
+        return true;
+    }
+    return false;
+} // end dequeue
+
+// Retrieves the item at the front of the queue. Throws PrecondViolatedExcept if the queue is empty.
+template<class ItemType>
+ItemType RingQueue<ItemType>::peekFront() const
+{
+    if (isEmpty())
+    {
+        throw PrecondViolatedExcept("peekFront() called with empty queue.");
+    }
+    return items[frontIndex];
+} // end peekFront
+
+// Removes all items from the queue, keeping the ring buffer.
+template<class ItemType>
+void RingQueue<ItemType>::clear()
+{
+    frontIndex = 0;
+    itemCount = 0;
+} // end clear
+
+// Gets the number of items in the queue.
+template<class ItemType>
+std::size_t RingQueue<ItemType>::size() const noexcept
+{
+    return itemCount;
+} // end size
+
+// Gets the item at a position counted from the front.
+template<class ItemType>
+const ItemType& RingQueue<ItemType>::operator[](std::size_t position) const noexcept
+{
+    return items[(frontIndex + position) & (capacity - 1)];
+} // end operator[]
+
+template<class ItemType>
+typename RingQueue<ItemType>::ConstIterator RingQueue<ItemType>::begin() const noexcept
+{
+    return ConstIterator(this, 0);
+} // end begin
+
+template<class ItemType>
+typename RingQueue<ItemType>::ConstIterator RingQueue<ItemType>::end() const noexcept
+{
+    return ConstIterator(this, itemCount);
+} // end end
+
+template<class ItemType>
+RingQueue<ItemType>::ConstIterator::ConstIterator(const RingQueue<ItemType>* iteratedQueue,
+    std::size_t startPosition) noexcept
+    : queue(iteratedQueue), position(startPosition)
+{ } // end constructor
+
+template<class ItemType>
+const ItemType& RingQueue<ItemType>::ConstIterator::operator*() const noexcept
+{
+    return (*queue)[position];
+} // end operator*
+
+template<class ItemType>
+typename RingQueue<ItemType>::ConstIterator& RingQueue<ItemType>::ConstIterator::operator++() noexcept
+{
+    ++position;
+    return *this;
+} // end operator++
+
+template<class ItemType>
+bool RingQueue<ItemType>::ConstIterator::operator==(const ConstIterator& other) const noexcept
+{
+    return queue == other.queue && position == other.position;
+} // end operator==
+
+template<class ItemType>
+bool RingQueue<ItemType>::ConstIterator::operator!=(const ConstIterator& other) const noexcept
+{
+    return !(*this == other);
+} // end operator!=
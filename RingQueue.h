@@ -0,0 +1,129 @@
+/** @file RingQueue.h
+ * @class RingQueue
+ * Implements a queue using a contiguous ring buffer and inherits from QueueInterface. The buffer doubles in size when
+ * full, and its contents can be read in order through iterators or positions without dequeueing. */
+
+#ifndef RING_QUEUE_
+#define RING_QUEUE_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include "QueueInterface.h"
+#include "PrecondViolatedExcept.h"
+
+template<class ItemType>
+class RingQueue : public QueueInterface<ItemType>
+{
+private:
+    /** Capacity of a new queue. Capacities are always powers of two so positions wrap with a mask. */
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    /** The ring buffer. */
+    std::unique_ptr<ItemType[]> items;
+
+    /** Index of the front item in the ring buffer. */
+    std::size_t frontIndex;
+
+    /** Number of items in the queue. */
+    std::size_t itemCount;
+
+    /** Number of items the ring buffer can hold. */
+    std::size_t capacity;
+
+    /** Doubles the capacity and moves the items to the start of a new ring buffer.
+     * @throws std::bad_alloc If the larger buffer cannot be allocated. */
+    void grow();
+
+public:
+    /** Forward iterator over the items of the queue from front to back. */
+    class ConstIterator
+    {
+    private:
+        const RingQueue<ItemType>* queue;
+        std::size_t position;
+
+    public:
+        ConstIterator(const RingQueue<ItemType>* iteratedQueue, std::size_t startPosition) noexcept;
+        const ItemType& operator*() const noexcept;
+        ConstIterator& operator++() noexcept;
+        bool operator==(const ConstIterator& other) const noexcept;
+        bool operator!=(const ConstIterator& other) const noexcept;
+    }; // end ConstIterator
+
+    /** Default constructor. Initializes an empty queue. */
+    RingQueue();
+
+    /** Copy constructor
+     * Creates a copy of another RingQueue.
+     * @param originalQueue The queue to be copied. */
+    RingQueue(const RingQueue<ItemType>& originalQueue);
+
+    /** Copy assignment operator
+     * Replaces the items of this queue with copies of the items of another RingQueue.
+     * @param originalQueue The queue to be copied.
+     * @return A reference to this queue. */
+    RingQueue<ItemType>& operator=(const RingQueue<ItemType>& originalQueue);
+
+    /** Destructor */
+    virtual ~RingQueue();
+
+    /** Sees whether this queue is empty.
+     * @pre None
+     * @post Does not change the queue
+     * @return True if the queue is empty, or false if not. */
+    bool isEmpty() const noexcept override;
+
+    /** Adds a new entry to the back of this queue.
+     * @pre None
+     * @post If the operation was successful, the item is at the back of the queue.
+     * @param someItem The object to be added as a new entry.
+     * @return True if the addition is successful, or false if the queue could not grow. */
+    bool enqueue(const ItemType& someItem) noexcept override;
+
+    /** Removes the front of this queue.
+     * @pre None
+     * @post If the operation was successful, the front of the queue has been removed.
+     * @return True if the removal is successful, or false if not. */
+    bool dequeue() noexcept override;
+
+    /** Returns a copy of the front of this queue.
+     * @pre The queue is not empty.
+     * @post A copy of the front of the queue has been returned, and the queue is unchanged.
+     * @return A copy of the front of the queue.
+     * @throws PrecondViolatedExcept if the queue is empty. */
+    ItemType peekFront() const override;
+
+    /** Removes all entries from this queue. The ring buffer is kept for reuse.
+     * @pre None
+     * @post The queue is empty. */
+    void clear() final override;
+
+    /** Gets the number of items in the queue.
+     * @pre None
+     * @post Does not change the queue.
+     * @return The number of items in the queue. */
+    std::size_t size() const noexcept;
+
+    /** Gets the item at a position counted from the front, without dequeueing.
+     * @pre position is less than size().
+     * @post Does not change the queue.
+     * @param position The position of the item, 0 for the front.
+     * @return A reference to the item. */
+    const ItemType& operator[](std::size_t position) const noexcept;
+
+    /** Gets an iterator to the front of the queue.
+     * @pre None
+     * @post Does not change the queue.
+     * @return An iterator to the front item. */
+    ConstIterator begin() const noexcept;
+
+    /** Gets an iterator past the back of the queue.
+     * @pre None
+     * @post Does not change the queue.
+     * @return An iterator one past the back item. */
+    ConstIterator end() const noexcept;
+}; // end RingQueue
+
+#include "RingQueue.cpp"
+#endif
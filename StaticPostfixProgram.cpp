@@ -0,0 +1,155 @@
+/** @file StaticPostfixProgram.cpp
+ * StaticPostfixProgram converts a string literal infix expression to postfix at compile time.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "StaticPostfixProgram.h"
+
+template<std::size_t MaxLength>
+constexpr StaticPostfixProgram<MaxLength>::StaticPostfixProgram(const char (&infixExpression)[MaxLength + 1])
+    : instructions{}, postfixText{}, instructionCount(0), maxStackDepth(0)
+{
+    char operatorStack[MaxLength + 1] = {};  // Operators and open parentheses waiting to be output
+    std::size_t operatorCount = 0;
+    std::size_t stackDepth = 0;
+    bool expectOperand = true;  // Operands and operators must alternate
+
+    for (std::size_t i = 0; i < MaxLength && infixExpression[i] != '\0'; ++i)
+    {
+        char currentChar = infixExpression[i];
+        if (currentChar >= 'A' && currentChar <= 'Z') currentChar = currentChar - 'A' + 'a';  // Convert to lowercase
+
+        if (currentChar == ' ')
+        {
+            continue;
+        }
+        else if (currentChar >= 'a' && currentChar <= 'f')  // Operand
+        {
+            if (!expectOperand) throw std::invalid_argument("Operand must follow an operator");
+            instructions[instructionCount] = { PostfixProgram::OpCode::PushVariable,
+                static_cast<std::uint32_t>(currentChar - 'a') };
+            postfixText[instructionCount++] = currentChar;
+            if (++stackDepth > maxStackDepth) maxStackDepth = stackDepth;
+            expectOperand = false;
+        }
+        else if (currentChar == '(')  // Opening parenthesis
+        {
+            if (!expectOperand) throw std::invalid_argument("Parenthesis must follow an operator");
+            operatorStack[operatorCount++] = currentChar;
+        }
+        else if (currentChar == '+' || currentChar == '-' || currentChar == '*' || currentChar == '/')
+        {
+            if (expectOperand) throw std::invalid_argument("Operator is missing an operand");
+            while (operatorCount > 0 && operatorStack[operatorCount - 1] != '(' &&
+                PostfixProgram::precedence(currentChar) <= PostfixProgram::precedence(operatorStack[operatorCount - 1]))
+            {
+                appendOperator(operatorStack[--operatorCount]);
+                --stackDepth;
+            }
+            operatorStack[operatorCount++] = currentChar;
+            expectOperand = true;
+        }
+        else if (currentChar == ')')  // Closing parenthesis
+        {
+            if (expectOperand) throw std::invalid_argument("Parenthesis is missing an operand");
+            while (operatorCount > 0 && operatorStack[operatorCount - 1] != '(')
+            {
+                appendOperator(operatorStack[--operatorCount]);
+                --stackDepth;
+            }
+            if (operatorCount == 0) throw std::invalid_argument("Unmatched closing parenthesis");
+            --operatorCount;  // Remove the open parenthesis
+        }
+        else
+        {
+            throw std::invalid_argument("Expression may only contain variables a-f, +,-,*,/ and parentheses");
+        }
+    }
+
+    if (expectOperand) throw std::invalid_argument("Expression is empty or ends with an operator");
+
+    // Add remaining operators to postfix expression
+    while (operatorCount > 0)
+    {
+        char nextOperator = operatorStack[--operatorCount];
+        if (nextOperator == '(') throw std::invalid_argument("Unmatched opening parenthesis");
+        appendOperator(nextOperator);
+    }
+} // end constructor
+
+template<std::size_t MaxLength>
+constexpr void StaticPostfixProgram<MaxLength>::appendOperator(char operatorChar)
+{
+    PostfixProgram::OpCode opcode = PostfixProgram::OpCode::Add;
+    switch (operatorChar)
+    {
+    case '+': opcode = PostfixProgram::OpCode::Add; break;
+    case '-': opcode = PostfixProgram::OpCode::Subtract; break;
+    case '*': opcode = PostfixProgram::OpCode::Multiply; break;
+    case '/': opcode = PostfixProgram::OpCode::Divide; break;
+    }
+    instructions[instructionCount] = { opcode, 0 };
+    postfixText[instructionCount++] = operatorChar;
+} // end appendOperator
+
+template<std::size_t MaxLength>
+constexpr std::size_t StaticPostfixProgram<MaxLength>::size() const noexcept
+{
+    return instructionCount;
+} // end size
+
+template<std::size_t MaxLength>
+constexpr std::size_t StaticPostfixProgram<MaxLength>::getMaxStackDepth() const noexcept
+{
+    return maxStackDepth;
+} // end getMaxStackDepth
+
+template<std::size_t MaxLength>
+constexpr std::string_view StaticPostfixProgram<MaxLength>::getPostfixText() const noexcept
+{
+    return std::string_view(postfixText, instructionCount);
+} // end getPostfixText
+
+template<std::size_t MaxLength>
+double StaticPostfixProgram<MaxLength>::evaluate(const int variableValues[]) const
+{
+    double evaluationStack[MaxLength + 1];  // Fixed size; the program was proven well formed at compile time
+    std::size_t top = 0;
+
+    for (std::size_t i = 0; i < instructionCount; ++i)
+    {
+        const PostfixProgram::Instruction& instruction = instructions[i];
+        if (instruction.opcode == PostfixProgram::OpCode::PushVariable)
+        {
+            evaluationStack[top++] = variableValues[instruction.operand];
+            continue;
+        }
+
+        double operand2 = evaluationStack[--top];
+        double& operand1 = evaluationStack[top - 1];
+        switch (instruction.opcode)
+        {
+        case PostfixProgram::OpCode::Add: operand1 = operand1 + operand2; break;
+        case PostfixProgram::OpCode::Subtract: operand1 = operand1 - operand2; break;
+        case PostfixProgram::OpCode::Multiply: operand1 = operand1 * operand2; break;
+        default:
+            if (operand2 == 0) throw std::runtime_error("Division by zero");
+            operand1 = operand1 / operand2;
+            break;
+        }
+    }
+    return evaluationStack[0];
+} // end evaluate
+
+template<std::size_t MaxLength>
+PostfixProgram StaticPostfixProgram<MaxLength>::toProgram() const
+{
+    return PostfixProgram(std::string(getPostfixText()));
+} // end toProgram
+
+template<std::size_t Size>
+constexpr StaticPostfixProgram<Size - 1> compileStatic(const char (&infixExpression)[Size])
+{
+    return StaticPostfixProgram<Size - 1>(infixExpression);
+} // end compileStatic
@@ -0,0 +1,89 @@
+/** @file StaticPostfixProgram.h
+ * @class StaticPostfixProgram
+ * Compile-time counterpart of PostfixProgram for formulas fixed at build time. A string literal infix expression is
+ * converted to a fixed-size postfix program by a constexpr shunting-yard pass that uses PostfixProgram::precedence,
+ * so it cannot diverge from the runtime converter. Malformed expressions fail to compile, and evaluation needs no
+ * parsing, validation or allocation.
+ *
+ * Usage: constexpr auto program = compileStatic("(a+b)*c"); */
+
+#ifndef STATIC_POSTFIX_PROGRAM_
+#define STATIC_POSTFIX_PROGRAM_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <stdexcept>
+#include "PostfixProgram.h"
+
+template<std::size_t MaxLength>
+class StaticPostfixProgram
+{
+private:
+    /** Flat array of instructions in postfix order. Only the first instructionCount are used. */
+    PostfixProgram::Instruction instructions[MaxLength];
+
+    /** The postfix expression, one character per instruction. */
+    char postfixText[MaxLength + 1];
+
+    /** Number of instructions in the program. */
+    std::size_t instructionCount;
+
+    /** Maximum number of values on the evaluation stack. */
+    std::size_t maxStackDepth;
+
+    /** Appends an operator to the program.
+     * @param operatorChar One of +,-,*,/. */
+    constexpr void appendOperator(char operatorChar);
+
+public:
+    /** Converts an infix expression of variables a-f, operators +,-,*,/ and parentheses. Spaces are ignored and
+     * uppercase letters are treated as lowercase, as in convertInfixToPostfix.
+     * @pre None
+     * @post The program holds the postfix form of the expression.
+     * @param infixExpression The null-terminated infix expression of at most MaxLength characters.
+     * @throws std::invalid_argument If the expression is malformed. In a constant expression this is a compile error. */
+    constexpr explicit StaticPostfixProgram(const char (&infixExpression)[MaxLength + 1]);
+
+    /** Gets the number of instructions in the program.
+     * @pre None
+     * @post Does not change the program.
+     * @return The number of instructions. */
+    constexpr std::size_t size() const noexcept;
+
+    /** Gets the maximum number of values on the evaluation stack.
+     * @pre None
+     * @post Does not change the program.
+     * @return The deepest evaluation stack the program needs. */
+    constexpr std::size_t getMaxStackDepth() const noexcept;
+
+    /** Gets the postfix form of the expression.
+     * @pre None
+     * @post Does not change the program.
+     * @return A view of the postfix text, valid for the lifetime of the program. */
+    constexpr std::string_view getPostfixText() const noexcept;
+
+    /** Evaluates the program against a table of variable values. The program was validated when it was compiled,
+     * so only division by zero can fail.
+     * @pre variableValues holds the values of variables a-f.
+     * @post Does not change the program.
+     * @param variableValues The values of variables a-f, indexed by slot.
+     * @return The result of the evaluation.
+     * @throws std::runtime_error If division by zero occurs. */
+    double evaluate(const int variableValues[]) const;
+
+    /** Creates the equivalent runtime program.
+     * @pre None
+     * @post Does not change the program.
+     * @return A PostfixProgram compiled from the same postfix text. */
+    PostfixProgram toProgram() const;
+}; // end StaticPostfixProgram
+
+/** Compiles a string literal infix expression into a StaticPostfixProgram.
+ * @param infixExpression The infix expression literal.
+ * @return The compiled program. Malformed expressions are a compile error when used in a constant expression. */
+template<std::size_t Size>
+constexpr StaticPostfixProgram<Size - 1> compileStatic(const char (&infixExpression)[Size]);
+
+#include "StaticPostfixProgram.cpp"
+#endif
@@ -0,0 +1,81 @@
+/** @file SymbolTable.cpp
+ * SymbolTable maps variable names to dense slots under a mutex.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable()
+{
+    for (char name = 'a'; name < 'a' + static_cast<char>(PREDEFINED_COUNT); ++name)
+    {
+        slotIndex.emplace(std::string(1, name), static_cast<std::uint32_t>(names.size()));
+        names.emplace_back(1, name);
+    }
+} // end default constructor
+
+std::string SymbolTable::toKey(std::string_view name)
+{
+    std::string key(name);
+    for (char& currentChar : key)
+    {
+        currentChar = static_cast<char>(std::tolower(static_cast<unsigned char>(currentChar)));
+    }
+    return key;
+} // end toKey
+
+bool SymbolTable::isValidName(std::string_view name) noexcept
+{
+    if (name.empty() || !std::isalpha(static_cast<unsigned char>(name[0]))) return false;
+
+    for (char currentChar : name)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(currentChar)) && currentChar != '_') return false;
+    }
+    return true;
+} // end isValidName
+
+std::uint32_t SymbolTable::intern(std::string_view name)
+{
+    if (!isValidName(name))
+    {
+        throw PrecondViolatedExcept("intern() called with an invalid variable name: " + std::string(name));
+    }
+
+    std::string key = toKey(name);
+    std::lock_guard<std::mutex> lock(tableMutex);
+
+    auto found = slotIndex.find(key);
+    if (found != slotIndex.end()) return found->second;
+
+    std::uint32_t slot = static_cast<std::uint32_t>(names.size());
+    names.push_back(key);
+    slotIndex.emplace(std::move(key), slot);
+    return slot;
+} // end intern
+
+std::uint32_t SymbolTable::find(std::string_view name) const
+{
+    std::string key = toKey(name);
+    std::lock_guard<std::mutex> lock(tableMutex);
+
+    auto found = slotIndex.find(key);
+    return found == slotIndex.end() ? NO_SLOT : found->second;
+} // end find
+
+std::string SymbolTable::getName(std::uint32_t slot) const
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    if (slot >= names.size())
+    {
+        throw PrecondViolatedExcept("getName() called with a slot that has no name.");
+    }
+    return names[slot];
+} // end getName
+
+std::size_t SymbolTable::size() const
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return names.size();
+} // end size
@@ -0,0 +1,89 @@
+/** @file SymbolTable.h
+ * @class SymbolTable
+ * Interns variable names into dense slot indices. Names are looked up once, when an expression is compiled, so
+ * evaluation indexes an array of values by slot and never hashes a string. Variables a-f are interned in every
+ * table as slots 0-5, matching the original fixed variables. Names are case-insensitive. A table can be shared by
+ * many evaluators on different threads. */
+
+#ifndef SYMBOL_TABLE_
+#define SYMBOL_TABLE_
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "PrecondViolatedExcept.h"
+
+class SymbolTable
+{
+public:
+    /** Number of predefined variables, a-f, which always have slots 0-5. */
+    static constexpr std::uint32_t PREDEFINED_COUNT = 6;
+
+    /** Slot returned by find for names that were never interned. */
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+
+private:
+    /** Index from lowercase name to slot. */
+    std::unordered_map<std::string, std::uint32_t> slotIndex;
+
+    /** Lowercase name of each slot. */
+    std::vector<std::string> names;
+
+    /** Guards slotIndex and names. */
+    mutable std::mutex tableMutex;
+
+    /** Lowercases a name.
+     * @pre None
+     * @post None
+     * @param name The name to lowercase.
+     * @return The lowercase name. */
+    static std::string toKey(std::string_view name);
+
+public:
+    /** Default constructor. Creates a table holding the predefined variables a-f. */
+    SymbolTable();
+
+    /** Checks whether text is a valid variable name: a letter followed by letters, digits or underscores.
+     * @pre None
+     * @post None
+     * @param name The text to check.
+     * @return True if name is a valid variable name. */
+    static bool isValidName(std::string_view name) noexcept;
+
+    /** Gets the slot of a name, adding the name if it is new.
+     * @pre None
+     * @post The table holds the name.
+     * @param name The variable name.
+     * @return The slot of the name.
+     * @throws PrecondViolatedExcept If name is not a valid variable name. */
+    std::uint32_t intern(std::string_view name);
+
+    /** Gets the slot of a name without adding it.
+     * @pre None
+     * @post None
+     * @param name The variable name.
+     * @return The slot of the name, or NO_SLOT if the name was never interned. */
+    std::uint32_t find(std::string_view name) const;
+
+    /** Gets the name of a slot.
+     * @pre None
+     * @post None
+     * @param slot The slot.
+     * @return The lowercase name of the slot.
+     * @throws PrecondViolatedExcept If the slot was never assigned. */
+    std::string getName(std::uint32_t slot) const;
+
+    /** Gets the number of interned names, which is also the number of slots.
+     * @pre None
+     * @post None
+     * @return The number of names, at least PREDEFINED_COUNT. */
+    std::size_t size() const;
+}; // end SymbolTable
+
+#include "SymbolTable.cpp"
+#endif
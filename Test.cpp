@@ -6,11 +6,33 @@
 
 #include <iostream>
 #include "InfixToPostfixEvaluation.h"
+#include "ParallelEvaluator.h"
+#include "LinkedStack.h"
+#include "VariableFileLoader.h"
+#include "ExpressionStreamProcessor.h"
+#include "StaticPostfixProgram.h"
+#include "ExpressionTemplate.h"
+#include "BatchInfixConverter.h"
+#include "IncrementalEvaluator.h"
+#include "MappedProgramLibrary.h"
+#include "LockFreeQueue.h"
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <limits>
 
 using namespace std;
 
-int main()
+int main(int argc, char* argv[])
 {
+	// Streaming mode: Test --stream [expressionFile | -] [--values file] [--rows file] [--pipeline]
+	if (argc > 1 && string(argv[1]) == "--stream")
+	{
+		return ExpressionStreamProcessor::runFromCommandLine(argc - 2, argv + 2);
+	}
+
 	// Testing valid values
 	cout << "=== Valid Values ===" << endl;
 
@@ -131,6 +153,26 @@ int main()
 		cout << "Expected output: Invalid postfix expression" << endl << endl;
 	}
 
+	// Testing adjacent operands, which must not merge into one name or number
+	InfixToPostfixEvaluation adjacentEvaluator;
+	adjacentEvaluator.readValuesFromFile("variables.txt");
+	adjacentEvaluator.setVariable("ab", 42);
+	for (const char* adjacentExpression : { "a b", "1 2" })
+	{
+		try
+		{
+			adjacentEvaluator.convertInfixToPostfix(adjacentExpression);
+			cout << "Postfix expression: " << adjacentEvaluator.getPostfixExpression() << endl;
+			result = adjacentEvaluator.evaluatePostfixExpression();
+			cout << "Result is: " << result << endl;
+		}
+		catch (const std::runtime_error& error)
+		{
+			cout << "Caught exception: " << error.what() << endl;
+		}
+		cout << "Expected output: " << adjacentExpression << ", Invalid postfix expression" << endl << endl;
+	}
+
 	// Testing no operators
 	try
 	{
@@ -161,7 +203,622 @@ int main()
 		cout << "Expected output: file does not contain enough values" << endl << endl;
 	}
 	cout << endl;
-	
+
+	// Testing a compiled program evaluated more than once
+	cout << "=== Compiled Program ===" << endl;
+	evaluator.readValuesFromFile("variables.txt");
+	evaluator.convertInfixToPostfix("(a+b)*c");
+	cout << "Result is: " << evaluator.evaluatePostfixExpression() << endl;
+	cout << "Result again is: " << evaluator.evaluatePostfixExpression() << endl;
+	cout << "Should be: 225 both times" << endl << endl;
+
+	// Evaluating the same compiled program against a different variable table
+	int otherValues[] = { 1, 2, 3, 4, 5, 6 };
+	std::shared_ptr<const PostfixProgram> program = evaluator.getCompiledProgram();
+	cout << "Result with other values: " << program->evaluate(otherValues) << endl;
+	cout << "Should be: 9" << endl;
+	cout << "Max stack depth: " << program->getMaxStackDepth() << endl;
+	cout << "Should be: 2" << endl << endl;
+
+	// Testing batch evaluation over columns of variable values
+	cout << "=== Batch Evaluation ===" << endl;
+	VariableColumns columns;
+	int firstRow[] = { 5, 10, 15, 20, 25, 30 };
+	columns.addRow(firstRow);
+	columns.addRow(otherValues);
+	std::vector<double> batchResults = evaluator.evaluatePostfixExpressionBatch(columns);
+	cout << "Batch results: " << batchResults[0] << " " << batchResults[1] << endl;
+	cout << "Should be: 225 9" << endl << endl;
+
+	// Testing that a zero divisor in any row of a batch is detected
+	try
+	{
+		int zeroRow[] = { 5, 0, 15, 20, 25, 30 };
+		columns.addRow(zeroRow);
+		evaluator.convertInfixToPostfix("a/b");
+		batchResults = evaluator.evaluatePostfixExpressionBatch(columns);
+		cout << "Batch results: " << batchResults[0] << " " << batchResults[1] << " " << batchResults[2] << endl;
+	}
+	catch (const std::runtime_error& error)
+	{
+		cout << "Caught exception: " << error.what() << endl;
+		cout << "Expected output: Division by zero" << endl << endl;
+	}
+
+	// Testing parallel evaluation over many rows against the serial batch results
+	cout << "=== Parallel Evaluation ===" << endl;
+	VariableColumns manyRows;
+	for (int row = 0; row < 100000; ++row)
+	{
+		manyRows.addRow(row % 2 == 0 ? firstRow : otherValues);
+	}
+	evaluator.convertInfixToPostfix("a*(b+c)*(d-e)+f");
+	ParallelEvaluator parallelEvaluator(4, 1024);
+	std::vector<double> parallelResults = parallelEvaluator.evaluateBatch(*evaluator.getCompiledProgram(), manyRows);
+	std::vector<double> serialResults = evaluator.evaluatePostfixExpressionBatch(manyRows);
+	cout << "Parallel results match serial results: " << (parallelResults == serialResults ? "yes" : "no") << endl;
+	cout << "Should be: yes" << endl << endl;
+
+	// Testing the array stack past its inline buffer
+	cout << "=== Array Stack ===" << endl;
+	ArrayStack<int, 4> arrayStack;
+	for (int item = 1; item <= 100; ++item)
+	{
+		arrayStack.push(item);
+	}
+	cout << "Size: " << arrayStack.size() << ", top: " << arrayStack.peek() << endl;
+	cout << "Should be: Size: 100, top: 100" << endl;
+	int poppedSum = 0;
+	while (!arrayStack.isEmpty())
+	{
+		poppedSum += arrayStack.peek();
+		arrayStack.pop();
+	}
+	cout << "Sum of popped items: " << poppedSum << endl;
+	cout << "Should be: 5050" << endl << endl;
+
+	// Testing the ring queue after it wraps around and grows
+	cout << "=== Ring Queue ===" << endl;
+	RingQueue<int> ringQueue;
+	for (int item = 1; item <= 10; ++item)
+	{
+		ringQueue.enqueue(item);
+	}
+	for (int item = 1; item <= 8; ++item)
+	{
+		ringQueue.dequeue();
+	}
+	for (int item = 11; item <= 30; ++item)
+	{
+		ringQueue.enqueue(item);
+	}
+	int iteratedSum = 0;
+	for (int item : ringQueue)
+	{
+		iteratedSum += item;
+	}
+	cout << "Size: " << ringQueue.size() << ", front: " << ringQueue.peekFront() << ", sum: " << iteratedSum << endl;
+	cout << "Should be: Size: 22, front: 9, sum: 429" << endl;
+
+	// Viewing the postfix expression without copying it
+	evaluator.convertInfixToPostfix("a*(b+c)*(d-e)+f");
+	cout << "Postfix view: " << evaluator.getPostfixExpressionView() << endl;
+	cout << "Should be: abc+*de-*f+" << endl << endl;
+
+	// Testing a linked stack whose nodes come from an arena
+	cout << "=== Arena Linked Stack ===" << endl;
+	{
+		char arenaBuffer[16384];
+		std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+		PmrLinkedStack<int> arenaStack{ std::pmr::polymorphic_allocator<int>(&arena) };
+		for (int item = 1; item <= 100; ++item)
+		{
+			arenaStack.push(item);
+		}
+		PmrLinkedStack<int> arenaCopy(arenaStack);
+		int arenaSum = 0;
+		while (!arenaCopy.isEmpty())
+		{
+			arenaSum += arenaCopy.peek();
+			arenaCopy.pop();
+		}
+		cout << "Top: " << arenaStack.peek() << ", sum of copied items: " << arenaSum << endl;
+		cout << "Should be: Top: 100, sum of copied items: 5050" << endl << endl;
+	} // The stacks are destroyed before the arena releases all nodes at once
+
+	// Testing the bulk loader with valid and invalid rows
+	cout << "=== Bulk Variable Loading ===" << endl;
+	VariableColumns loadedRows;
+	VariableFileLoader::loadFile("variables.txt", loadedRows);
+	VariableFileLoader::loadFile("boundaryVariables.txt", loadedRows);
+	std::vector<VariableFileLoader::RowError> rowErrors = VariableFileLoader::loadFile("invalidVariables.txt", loadedRows);
+	cout << "Rows loaded: " << loadedRows.getRowCount() << ", rows skipped: " << rowErrors.size() << endl;
+	cout << "Should be: Rows loaded: 2, rows skipped: 1" << endl;
+	for (const VariableFileLoader::RowError& rowError : rowErrors)
+	{
+		cout << "Line " << rowError.lineNumber << ": " << rowError.message << endl;
+	}
+	cout << "Should be: Line 1: Row does not contain enough values." << endl;
+	evaluator.convertInfixToPostfix("a+b");
+	batchResults = evaluator.evaluatePostfixExpressionBatch(loadedRows);
+	cout << "Batch results: " << batchResults[0] << " " << batchResults[1] << endl;
+	cout << "Should be: 15 5" << endl << endl;
+
+	// Testing the streaming processor on a stream of expressions
+	cout << "=== Stream Processing ===" << endl;
+	ExpressionStreamProcessor streamProcessor;
+	streamProcessor.readValuesFromFile("variables.txt");
+	std::istringstream expressionStream("a+b*c\n\n(a+b)*c\na/(b-b)\n");
+	std::ostringstream resultStream;
+	ExpressionStreamProcessor::Report streamReport = streamProcessor.process(expressionStream, resultStream);
+	cout << resultStream.str();
+	cout << "Should be: abc*+ 155, ab+c* 225, abb-/ error: Division by zero" << endl;
+	cout << "Expressions: " << streamReport.expressionCount << ", errors: " << streamReport.errorCount << endl;
+	cout << "Should be: Expressions: 3, errors: 1" << endl;
+
+	// An unmatched closing parenthesis is reported for its line and the stream goes on
+	std::istringstream unbalancedStream("a+b\na)\n)(\nb*c\n");
+	std::ostringstream unbalancedResults;
+	ExpressionStreamProcessor::Report unbalancedReport = streamProcessor.process(unbalancedStream, unbalancedResults);
+	cout << unbalancedResults.str();
+	cout << "Should be: ab+ 15, a error: Invalid postfix expression, ( error: Invalid postfix expression, bc* 150" << endl;
+	cout << "Expressions: " << unbalancedReport.expressionCount << ", errors: " << unbalancedReport.errorCount << endl;
+	cout << "Should be: Expressions: 4, errors: 2" << endl;
+
+	// Running a longer stream through the pipelined stages, with small batches so many batches are in flight
+	std::string pipelineInput;
+	for (int i = 0; i < 2000; ++i)
+	{
+		pipelineInput += (i % 7 == 0) ? "a/(b-b)\n" : "(a+b)*c-d/e+" + std::to_string(i) + "\n";
+	}
+	std::istringstream serialInput(pipelineInput);
+	std::istringstream pipelinedInput(pipelineInput);
+	std::ostringstream serialOutput;
+	std::ostringstream pipelinedOutput;
+	streamProcessor.process(serialInput, serialOutput);
+	ExpressionStreamProcessor::Report pipelineReport = streamProcessor.processPipelined(pipelinedInput, pipelinedOutput, 16);
+	cout << "Pipeline output matches serial output: " << (serialOutput.str() == pipelinedOutput.str() ? "yes" : "no") << endl;
+	cout << "Should be: yes" << endl;
+	cout << "Expressions: " << pipelineReport.expressionCount << ", errors: " << pipelineReport.errorCount << endl;
+	cout << "Should be: Expressions: 2000, errors: 286" << endl;
+
+	// Malformed lines in the pipelined stages are reported like any other error
+	std::istringstream unbalancedPipelineInput("a+b\na)\n)(\nb*c\n");
+	std::ostringstream unbalancedPipelineOutput;
+	ExpressionStreamProcessor::Report unbalancedPipelineReport = streamProcessor.processPipelined(unbalancedPipelineInput, unbalancedPipelineOutput, 1);
+	cout << "Pipeline output matches serial output: " << (unbalancedPipelineOutput.str() == unbalancedResults.str() ? "yes" : "no")
+		<< ", errors: " << unbalancedPipelineReport.errorCount << endl;
+	cout << "Should be: Pipeline output matches serial output: yes, errors: 2" << endl;
+
+	// A row that divides by zero is reported on its own, and the other rows keep their results
+	std::ofstream("testRows.txt") << "5 10 15 20 25 30\n5 0 15 20 25 30\n";
+	ExpressionStreamProcessor rowProcessor;
+	rowProcessor.loadVariableRows("testRows.txt");
+	std::remove("testRows.txt");
+	std::istringstream rowInput("a/b\na+b\n");
+	std::istringstream pipelinedRowInput("a/b\na+b\n");
+	std::ostringstream rowOutput;
+	std::ostringstream pipelinedRowOutput;
+	ExpressionStreamProcessor::Report rowReport = rowProcessor.process(rowInput, rowOutput);
+	rowProcessor.processPipelined(pipelinedRowInput, pipelinedRowOutput);
+	cout << rowOutput.str();
+	cout << "Should be: ab/ 0.5 error: Division by zero, ab+ 15 5" << endl;
+	cout << "Errors: " << rowReport.errorCount << ", pipeline output matches serial output: "
+		<< (pipelinedRowOutput.str() == rowOutput.str() ? "yes" : "no") << endl;
+	cout << "Should be: Errors: 1, pipeline output matches serial output: yes" << endl << endl;
+
+	// Testing an expression converted at compile time
+	cout << "=== Compile-Time Conversion ===" << endl;
+	constexpr auto staticProgram = compileStatic("a*(b+c)*(d-e)+f");
+	static_assert(staticProgram.getPostfixText() == "abc+*de-*f+", "Compile-time conversion must match runtime conversion");
+	cout << "Postfix expression: " << staticProgram.getPostfixText() << ", result: " << staticProgram.evaluate(firstRow) << endl;
+	cout << "Should be: Postfix expression: abc+*de-*f+, result: -595" << endl << endl;
+
+	// Testing a formula written as a C++ expression
+	cout << "=== Expression Templates ===" << endl;
+	auto templateFormula = var<'a'>() * (var<'b'>() + var<'c'>()) * (var<'d'>() - var<'e'>()) + var<'f'>();
+	cout << "Postfix expression: " << templateFormula.toPostfix() << ", result: " << templateFormula.evaluate(firstRow) << endl;
+	cout << "Should be: Postfix expression: abc+*de-*f+, result: -595" << endl;
+	auto scaledFormula = (var<'a'>() + var<'b'>()) * 2.5;
+	cout << "Postfix expression: " << scaledFormula.toPostfix() << ", result: " << scaledFormula.evaluate(firstRow)
+		<< ", program result: " << scaledFormula.toProgram().evaluate(firstRow) << endl;
+	cout << "Should be: Postfix expression: a b + 2.5 *, result: 37.5, program result: 37.5" << endl;
+	auto negativeZeroFormula = var<'a'>() * (-0.0);
+	cout << "Postfix expression: " << negativeZeroFormula.toPostfix() << ", sign of result: "
+		<< (std::signbit(negativeZeroFormula.evaluate(firstRow)) ? "-" : "+") << ", sign of program result: "
+		<< (std::signbit(negativeZeroFormula.toProgram().evaluate(firstRow)) ? "-" : "+") << endl;
+	cout << "Should be: Postfix expression: a001-**, sign of result: -, sign of program result: -" << endl;
+	try
+	{
+		(var<'a'>() * std::numeric_limits<double>::infinity()).toPostfix();
+	}
+	catch (const std::runtime_error& e)
+	{
+		cout << "Error: " << e.what() << endl;
+	}
+	cout << "Should be: Error: Constant has no postfix form: inf" << endl << endl;
+
+	// Testing conversion of many lines at once
+	cout << "=== Batch Conversion ===" << endl;
+	BatchInfixConverter batchConverter;
+	size_t convertedCount = batchConverter.convert("a+b*c\n\n(A+B)*c\r\nprice*(1+Rate)\n");
+	cout << "Expressions: " << convertedCount << ", postfix: " << batchConverter.getPostfix(0) << ", "
+		<< batchConverter.getPostfix(2) << ", " << batchConverter.getPostfix(3) << ", blank line length: " << batchConverter.getPostfix(1).size() << endl;
+	cout << "Should be: Expressions: 4, postfix: abc*+, ab+c*, price 1 rate + *, blank line length: 0" << endl;
+	cout << "Result: " << batchConverter.compile(2, std::make_shared<SymbolTable>())->evaluate(firstRow) << endl;
+	cout << "Should be: Result: 225" << endl;
+	batchConverter.convert("a)+b\na b\n");
+	cout << "Postfix: " << batchConverter.getPostfix(0) << ", status: "
+		<< EvaluationResult::describe(batchConverter.compile(0, std::make_shared<SymbolTable>())->getStatus())
+		<< ", postfix: " << batchConverter.getPostfix(1) << ", status: "
+		<< EvaluationResult::describe(batchConverter.compile(1, std::make_shared<SymbolTable>())->getStatus()) << endl;
+	cout << "Should be: Postfix: ab+, status: Invalid postfix expression, postfix: a b, status: Invalid postfix expression" << endl;
+	try
+	{
+		batchConverter.getPostfix(4);
+	}
+	catch (const PrecondViolatedExcept& e)
+	{
+		cout << "Error: " << e.what() << endl;
+	}
+	cout << "Should be: Error: Precondition Violated Exception: getPostfix() called with an invalid expression index." << endl << endl;
+
+	// Testing the cache of compiled expressions
+	cout << "=== Expression Cache ===" << endl;
+	std::shared_ptr<CompiledExpressionCache> expressionCache = std::make_shared<CompiledExpressionCache>(2);
+	evaluator.setExpressionCache(expressionCache);
+	evaluator.convertInfixToPostfix("a+b");
+	evaluator.convertInfixToPostfix("A + B");
+	cout << "Postfix expression: " << evaluator.getPostfixExpression() << ", result: " << evaluator.evaluatePostfixExpression() << endl;
+	cout << "Should be: Postfix expression: ab+, result: 15" << endl;
+	evaluator.convertInfixToPostfix("a*b");
+	evaluator.convertInfixToPostfix("a-b");
+	evaluator.convertInfixToPostfix("a+b");
+	CompiledExpressionCache::Statistics cacheStatistics = expressionCache->getStatistics();
+	cout << "Hits: " << cacheStatistics.hits << ", misses: " << cacheStatistics.misses << ", evictions: " << cacheStatistics.evictions << ", size: " << cacheStatistics.size << endl;
+	cout << "Should be: Hits: 1, misses: 4, evictions: 2, size: 2" << endl << endl;
+	evaluator.setExpressionCache(nullptr);
+
+	// Testing that repeated subexpressions are computed once
+	cout << "=== Optimization ===" << endl;
+	evaluator.convertInfixToPostfix("(a+b)*(a+b)");
+	cout << "Postfix expression: " << evaluator.getPostfixExpression() << ", result: " << evaluator.evaluatePostfixExpression() << ", instructions: " << evaluator.getCompiledProgram()->size() << endl;
+	cout << "Should be: Postfix expression: ab+ab+*, result: 225, instructions: 6" << endl;
+	batchResults = evaluator.evaluatePostfixExpressionBatch(columns);
+	cout << "Batch results: " << batchResults[0] << " " << batchResults[1] << endl;
+	cout << "Should be: 225 9" << endl;
+	evaluator.convertInfixToPostfix("a*(b+c)*(d-e)+f");
+	cout << "Result: " << evaluator.evaluatePostfixExpression() << ", instructions: " << evaluator.getCompiledProgram()->size() << endl;
+	cout << "Should be: Result: -595, instructions: 11" << endl;
+
+	// Testing rewrites that assume finite values
+	PostfixOptimizer finiteOptimizer(ExpressionDag::Options{ true });
+	std::shared_ptr<const PostfixProgram> optimizedProgram = finiteOptimizer.optimize(std::make_shared<const PostfixProgram>("aa-"));
+	cout << "a-a result: " << optimizedProgram->evaluate(firstRow) << ", instructions: " << optimizedProgram->size() << endl;
+	cout << "Should be: a-a result: 0, instructions: 1" << endl;
+	try
+	{
+		finiteOptimizer.optimize(std::make_shared<const PostfixProgram>("abb-/"))->evaluate(firstRow);
+	}
+	catch (const std::runtime_error& e)
+	{
+		cout << "Error: " << e.what() << endl;
+	}
+	cout << "Should be: Error: Division by zero" << endl << endl;
+
+	// Testing that a variable change only recomputes the subexpressions that use it
+	cout << "=== Incremental Evaluation ===" << endl;
+	IncrementalEvaluator incremental;
+	IncrementalEvaluator::ExpressionId sumId = incremental.addExpression("a+b");
+	IncrementalEvaluator::ExpressionId productId = incremental.addExpression("(a+b)*c");
+	IncrementalEvaluator::ExpressionId quotientId = incremental.addExpression("d/e");
+	for (char name = 'a'; name <= 'f'; ++name)
+	{
+		incremental.setVariable(name, firstRow[name - 'a']);
+	}
+	cout << "Results: " << incremental.getValue(sumId) << " " << incremental.getValue(productId) << " " << incremental.getValue(quotientId) << endl;
+	cout << "Should be: 15 225 0.8" << endl;
+	incremental.setVariable('c', 2);
+	cout << "After c = 2: " << incremental.getValue(productId) << ", nodes recomputed: " << incremental.getLastUpdateCount() << endl;
+	cout << "Should be: After c = 2: 30, nodes recomputed: 2" << endl;
+	incremental.setVariable('e', 0);
+	try
+	{
+		incremental.getValue(quotientId);
+	}
+	catch (const std::runtime_error& e)
+	{
+		cout << "Error: " << e.what() << ", a+b is still: " << incremental.getValue(sumId) << endl;
+	}
+	cout << "Should be: Error: Division by zero, a+b is still: 15" << endl;
+	try
+	{
+		incremental.addExpression("a)");
+	}
+	catch (const std::runtime_error& e)
+	{
+		cout << "Error: " << e.what() << ", expressions: " << incremental.getExpressionCount() << endl;
+	}
+	cout << "Should be: Error: Invalid postfix expression, expressions: 3" << endl << endl;
+
+	// Testing variable names longer than one letter and numeric literals
+	cout << "=== Named Variables and Literals ===" << endl;
+	InfixToPostfixEvaluation namedEvaluator;
+	namedEvaluator.readValuesFromFile("variables.txt");
+	namedEvaluator.setVariable("price", 10);
+	namedEvaluator.setVariable("taxRate", 0.25);
+	namedEvaluator.convertInfixToPostfix("price * (1 + taxRate) - 2.5");
+	cout << "Postfix expression: " << namedEvaluator.getPostfixExpression() << ", result: " << namedEvaluator.evaluatePostfixExpression() << endl;
+	cout << "Should be: Postfix expression: price 1 taxrate + * 2.5 -, result: 10" << endl;
+	namedEvaluator.convertInfixToPostfix("a+2");
+	cout << "Postfix expression: " << namedEvaluator.getPostfixExpression() << ", result: " << namedEvaluator.evaluatePostfixExpression() << endl;
+	cout << "Should be: Postfix expression: a2+, result: 7" << endl;
+	try
+	{
+		namedEvaluator.convertInfixToPostfix("a*g");
+		namedEvaluator.evaluatePostfixExpression();
+	}
+	catch (const std::runtime_error& e)
+	{
+		cout << "Error: " << e.what() << endl;
+	}
+	cout << "Should be: Error: Unknown variable: g" << endl;
+
+	// Evaluating named variables over columns, one column per slot of the symbol table
+	namedEvaluator.convertInfixToPostfix("price * (1 + taxRate) - 2.5");
+	std::shared_ptr<SymbolTable> symbols = namedEvaluator.getSymbolTable();
+	VariableColumns namedColumns(symbols->size());
+	std::vector<double> namedRow(symbols->size(), 0);
+	namedRow[symbols->find("price")] = 20;
+	namedRow[symbols->find("taxrate")] = 0.5;
+	namedColumns.addRow(namedRow.data());
+	cout << "Batch result: " << namedEvaluator.evaluatePostfixExpressionBatch(namedColumns)[0] << endl;
+	cout << "Should be: Batch result: 27.5" << endl << endl;
+
+#ifdef POSTFIX_ENABLE_STATS
+	// Testing the hot path counters, only available when compiled with POSTFIX_ENABLE_STATS
+	cout << "=== Statistics ===" << endl;
+	PostfixStatistics::reset();
+	namedEvaluator.convertInfixToPostfix("a*(b+(c-d))");
+	namedEvaluator.evaluatePostfixExpression();
+	namedEvaluator.getPostfixExpression();
+	namedEvaluator.convertInfixToPostfix("a/(b-b)");
+	try
+	{
+		namedEvaluator.evaluatePostfixExpression();
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	LinkedStack<int> countedStack;
+	countedStack.push(1);
+	countedStack.push(2);
+	PostfixStatistics::Snapshot statistics = PostfixStatistics::getSnapshot();
+	cout << "Convert calls: " << statistics.phases[0].calls << ", evaluate calls: " << statistics.phases[1].calls << ", stringify calls: " << statistics.phases[2].calls << endl;
+	cout << "Should be: Convert calls: 2, evaluate calls: 2, stringify calls: 1" << endl;
+	cout << "Peak operator stack: " << statistics.peakOperatorStackDepth << ", peak evaluation stack: " << statistics.peakEvaluationStackDepth << endl;
+	cout << "Should be: Peak operator stack: 5, peak evaluation stack: 4" << endl;
+	cout << "Node allocations: " << statistics.nodeAllocations << ", division by zero errors: " << statistics.exceptions[static_cast<size_t>(PostfixStatistics::ErrorKind::DivisionByZero)] << endl;
+	cout << "Should be: Node allocations: 2, division by zero errors: 1" << endl << endl;
+#endif
+
+	// Testing a library of compiled programs written to a file and read back through a memory mapping
+	cout << "=== Program Library ===" << endl;
+	{
+		InfixToPostfixEvaluation libraryEvaluator;
+		std::vector<std::shared_ptr<const PostfixProgram>> libraryPrograms;
+		for (const char* expression : { "(a+b)*c", "(a+b)*(a+b)", "price * 2.5 - f" })
+		{
+			libraryEvaluator.convertInfixToPostfix(expression);
+			libraryPrograms.push_back(libraryEvaluator.getCompiledProgram());
+		}
+		MappedProgramLibrary::write("testPrograms.pfxl", libraryPrograms);
+
+		{
+			MappedProgramLibrary library("testPrograms.pfxl");
+			std::shared_ptr<SymbolTable> librarySymbols = library.createSymbolTable();
+			std::vector<double> libraryValues = { 5, 10, 15, 20, 25, 30, 4 };  // Slot 6 is price
+			cout << "Programs: " << library.size() << ", price slot: " << librarySymbols->find("price") << endl;
+			cout << "Should be: Programs: 3, price slot: 6" << endl;
+			cout << "Results:";
+			for (std::size_t i = 0; i < library.size(); ++i)
+			{
+				cout << " " << library.getProgram(i).getPostfixText() << "=" << library.evaluate(i, libraryValues.data(), libraryValues.size());
+			}
+			cout << endl << "Should be: ab+c*=225 ab+ab+*=225 price 2.5 * f -=-20" << endl;
+			try
+			{
+				library.evaluate(2, libraryValues.data(), SymbolTable::PREDEFINED_COUNT);
+			}
+			catch (const std::runtime_error& e)
+			{
+				cout << "Error: " << e.what() << endl;
+			}
+			cout << "Should be: Error: Unknown variable: price" << endl;
+		}
+
+		std::ofstream("testPrograms.pfxl", std::ios::binary | std::ios::app) << "extra";  // Corrupt the file size
+		try
+		{
+			MappedProgramLibrary library("testPrograms.pfxl");
+		}
+		catch (const std::runtime_error& e)
+		{
+			cout << "Error: " << e.what() << endl;
+		}
+		cout << "Should be: Error: Invalid program library: file size does not match header" << endl;
+		std::remove("testPrograms.pfxl");
+
+		// A program that loads a temporary it never stored is read but reported as invalid
+		std::vector<PostfixProgram::Instruction> unstoredInstructions = { { PostfixProgram::OpCode::PushVariable, 0 },
+			{ PostfixProgram::OpCode::LoadTemporary, 0 }, { PostfixProgram::OpCode::Add, 0 } };
+		MappedProgramLibrary::write("testPrograms.pfxl", { std::make_shared<const PostfixProgram>(
+			std::move(unstoredInstructions), std::vector<double>(), 1, "a t +", nullptr) });
+		{
+			MappedProgramLibrary library("testPrograms.pfxl");
+			std::vector<double> libraryValues = { 5, 10, 15, 20, 25, 30 };
+			cout << "Status: " << EvaluationResult::describe(library.tryEvaluate(0, libraryValues.data(), libraryValues.size()).status) << endl;
+		}
+		cout << "Should be: Status: Invalid postfix expression" << endl << endl;
+		std::remove("testPrograms.pfxl");
+	}
+
+	// Testing one compiled program shared by threads that each evaluate it in their own context
+	cout << "=== Evaluation Contexts ===" << endl;
+	{
+		InfixToPostfixEvaluation sharedEvaluator;
+		sharedEvaluator.convertInfixToPostfix("rate * (a + b)");
+		std::shared_ptr<const PostfixProgram> sharedProgram = sharedEvaluator.getCompiledProgram();
+		std::vector<double> threadResults(4);
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < threadResults.size(); ++t)
+		{
+			threads.emplace_back([&, t]()
+			{
+				EvaluationContext threadContext = sharedEvaluator.createEvaluationContext();
+				std::uint32_t rateSlot = threadContext.getSlot("rate");
+				threadContext.setVariable(0u, 1);
+				threadContext.setVariable(1u, 2);
+				double sum = 0;
+				for (int i = 1; i <= 1000; ++i)
+				{
+					threadContext.setVariable(rateSlot, double(t + 1));
+					sum += threadContext.evaluate(*sharedProgram);
+				}
+				threadResults[t] = sum;
+			});
+		}
+		for (std::thread& thread : threads) thread.join();
+		cout << "Thread results:";
+		for (double result : threadResults) cout << " " << result;
+		cout << endl << "Should be: Thread results: 3000 6000 9000 12000" << endl;
+
+		EvaluationContext otherContext = sharedEvaluator.createEvaluationContext();
+		try
+		{
+			sharedEvaluator.evaluatePostfixExpression(otherContext);
+		}
+		catch (const std::runtime_error& e)
+		{
+			cout << "Error: " << e.what() << endl;
+		}
+		cout << "Should be: Error: Unknown variable: rate" << endl << endl;
+	}
+
+	// Stress testing the lock-free queue with several producer and consumer threads
+	cout << "=== Lock-Free Queue ===" << endl;
+	{
+		const long long itemsPerProducer = 100000;
+		const int producerCount = 4;
+		const int consumerCount = 4;
+		LockFreeQueue<long long> lockFreeQueue(256);
+		std::atomic<long long> consumedCount(0);
+		std::atomic<long long> consumedSum(0);
+		std::vector<std::thread> queueThreads;
+		for (int p = 0; p < producerCount; ++p)
+		{
+			queueThreads.emplace_back([&, p]()
+			{
+				for (long long i = 1; i <= itemsPerProducer; ++i)
+				{
+					while (!lockFreeQueue.enqueue(p * itemsPerProducer + i))  // Full, let a consumer catch up
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (int c = 0; c < consumerCount; ++c)
+		{
+			queueThreads.emplace_back([&]()
+			{
+				long long item = 0;
+				while (consumedCount.load() < producerCount * itemsPerProducer)
+				{
+					if (lockFreeQueue.tryDequeue(item))
+					{
+						consumedSum += item;
+						++consumedCount;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (std::thread& thread : queueThreads) thread.join();
+		long long totalItems = producerCount * itemsPerProducer;
+		cout << "Items: " << consumedCount.load() << ", sum matches: " << (consumedSum.load() == totalItems * (totalItems + 1) / 2 ? "yes" : "no")
+			<< ", empty: " << (lockFreeQueue.isEmpty() ? "yes" : "no") << endl;
+		cout << "Should be: Items: 400000, sum matches: yes, empty: yes" << endl;
+
+		LockFreeQueue<int> smallQueue(2);
+		bool thirdAccepted = smallQueue.enqueue(1) && smallQueue.enqueue(2) && smallQueue.enqueue(3);
+		int frontItem = 0;
+		smallQueue.tryDequeue(frontItem);
+		cout << "Third item accepted: " << (thirdAccepted ? "yes" : "no") << ", front: " << frontItem << ", peek: " << smallQueue.peekFront() << endl;
+		cout << "Should be: Third item accepted: no, front: 1, peek: 2" << endl << endl;
+	}
+
+	// Testing evaluation that reports errors as a status instead of throwing
+	cout << "=== Non-Throwing Evaluation ===" << endl;
+	{
+		InfixToPostfixEvaluation statusEvaluator;
+		statusEvaluator.convertInfixToPostfix("a/(b-b)");
+		EvaluationResult divisionResult = statusEvaluator.tryEvaluatePostfixExpression();
+		cout << "Status: " << EvaluationResult::describe(divisionResult.status) << endl;
+		cout << "Should be: Status: Division by zero" << endl;
+		EvaluationContext statusContext = statusEvaluator.createEvaluationContext();
+		statusContext.setVariable("a", 6);
+		statusContext.setVariable("b", 3);
+		const InfixToPostfixEvaluation& sharedStatusEvaluator = statusEvaluator;
+		EvaluationResult contextResult = sharedStatusEvaluator.tryEvaluatePostfixExpression(statusContext);
+		cout << "Status: " << EvaluationResult::describe(contextResult.status) << endl;
+		cout << "Should be: Status: Division by zero" << endl;
+
+		PostfixProgram invalidProgram("ab+*");
+		cout << "Status: " << EvaluationResult::describe(invalidProgram.getStatus()) << endl;
+		cout << "Should be: Status: Invalid postfix expression" << endl;
+
+		// Every seventh row divides by zero; the other rows are still evaluated
+		VariableColumns statusRows;
+		for (int row = 0; row < 1000; ++row)
+		{
+			int rowValues[] = { row, row % 7, 1, 1, 1, 1 };
+			statusRows.addRow(rowValues);
+		}
+		statusEvaluator.convertInfixToPostfix("a/b");
+		BatchEvaluationResult batch = statusEvaluator.tryEvaluatePostfixExpressionBatch(statusRows);
+		cout << "Row errors: " << batch.errorCount << ", row 7: " << (batch.hasRowError(7) ? "error" : "ok")
+			<< ", row 8: " << batch.values[8] << endl;
+		cout << "Should be: Row errors: 143, row 7: error, row 8: 8" << endl << endl;
+	}
+
+	// Testing the register backend against the stack interpreter
+	cout << "=== Register Backend ===" << endl;
+	{
+		InfixToPostfixEvaluation registerEvaluator;
+		registerEvaluator.readValuesFromFile("variables.txt");
+		registerEvaluator.setBackend(InfixToPostfixEvaluation::Backend::Register);
+		registerEvaluator.convertInfixToPostfix("(a+b)*(c-d)/e");
+		cout << "Result: " << registerEvaluator.evaluatePostfixExpression() << ", stack instructions: "
+			<< registerEvaluator.getCompiledProgram()->size() << ", register instructions: "
+			<< registerEvaluator.getRegisterProgram()->size() << endl;
+		cout << "Should be: Result: -3, stack instructions: 9, register instructions: 5" << endl;
+
+		registerEvaluator.convertInfixToPostfix("a/(b-b)");
+		try
+		{
+			registerEvaluator.evaluatePostfixExpression();
+		}
+		catch (const std::runtime_error& e)
+		{
+			cout << "Error: " << e.what() << endl;
+		}
+		cout << "Should be: Error: Division by zero" << endl << endl;
+	}
+
 	// User testing interface
 	cout << "=== User Input Testing ===" << endl;
 
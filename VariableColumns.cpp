@@ -0,0 +1,67 @@
+/** @file VariableColumns.cpp
+ * VariableColumns stores rows of variable values as one contiguous column per variable.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "VariableColumns.h"
+
+VariableColumns::VariableColumns() : VariableColumns(DEFAULT_COLUMN_COUNT)
+{ } // end default constructor
+
+VariableColumns::VariableColumns(std::size_t columnCount) : columns(columnCount), rowCount(0)
+{ } // end constructor
+
+std::size_t VariableColumns::getRowCount() const noexcept
+{
+    return rowCount;
+} // end getRowCount
+
+std::size_t VariableColumns::getColumnCount() const noexcept
+{
+    return columns.size();
+} // end getColumnCount
+
+void VariableColumns::reserve(std::size_t rowCapacity)
+{
+    for (std::vector<double>& column : columns)
+    {
+        column.reserve(rowCapacity);
+    }
+} // end reserve
+
+void VariableColumns::addRow(const double values[])
+{
+    for (std::size_t i = 0; i < columns.size(); ++i) // Append each value to its own column
+    {
+        columns[i].push_back(values[i]);
+    }
+    ++rowCount;
+} // end addRow
+
+void VariableColumns::addRow(const int values[])
+{
+    for (std::size_t i = 0; i < columns.size(); ++i) // Append each value to its own column
+    {
+        columns[i].push_back(values[i]);
+    }
+    ++rowCount;
+} // end addRow
+
+const double* VariableColumns::getColumn(std::size_t slot) const
+{
+    if (slot >= columns.size())
+    {
+        throw PrecondViolatedExcept("getColumn() called with an invalid variable slot.");
+    }
+    return columns[slot].data();
+} // end getColumn
+
+void VariableColumns::clear() noexcept
+{
+    for (std::vector<double>& column : columns)
+    {
+        column.clear();
+    }
+    rowCount = 0;
+} // end clear
@@ -0,0 +1,82 @@
+/** @file VariableColumns.h
+ * @class VariableColumns
+ * Stores many rows of variable values as structure-of-arrays columns, one contiguous array per variable slot,
+ * so a compiled program can be evaluated over all rows in blocks. By default there is one column for each of the
+ * variables a-f; more columns hold the variables of a SymbolTable past a-f. */
+
+#ifndef VARIABLE_COLUMNS_
+#define VARIABLE_COLUMNS_
+
+#include <cstddef>
+#include <vector>
+#include "PrecondViolatedExcept.h"
+
+class VariableColumns
+{
+public:
+    /** Number of variable columns by default, one for each variable a-f. */
+    static constexpr std::size_t DEFAULT_COLUMN_COUNT = 6;
+
+private:
+    /** One contiguous array of values per variable slot. */
+    std::vector<std::vector<double>> columns;
+
+    /** Number of rows stored in every column. */
+    std::size_t rowCount;
+
+public:
+    /** Default constructor. Creates DEFAULT_COLUMN_COUNT columns with no rows. */
+    VariableColumns();
+
+    /** Creates columns with no rows.
+     * @pre None
+     * @post The columns are empty.
+     * @param columnCount The number of variable slots, usually the size of a SymbolTable. */
+    explicit VariableColumns(std::size_t columnCount);
+
+    /** Gets the number of rows.
+     * @pre None
+     * @post Does not change the columns.
+     * @return The number of rows stored in every column. */
+    std::size_t getRowCount() const noexcept;
+
+    /** Gets the number of columns.
+     * @pre None
+     * @post Does not change the columns.
+     * @return The number of variable columns. */
+    std::size_t getColumnCount() const noexcept;
+
+    /** Reserves storage for a number of rows in every column.
+     * @pre None
+     * @post Rows can be added up to rowCapacity without reallocating.
+     * @param rowCapacity The number of rows to reserve. */
+    void reserve(std::size_t rowCapacity);
+
+    /** Appends one row of variable values.
+     * @pre values holds getColumnCount() values.
+     * @post The row count is increased by one.
+     * @param values The values of the variables for the new row, indexed by slot. */
+    void addRow(const double values[]);
+
+    /** Appends one row of integer variable values.
+     * @pre values holds getColumnCount() values.
+     * @post The row count is increased by one.
+     * @param values The values of the variables for the new row, indexed by slot. */
+    void addRow(const int values[]);
+
+    /** Gets the contiguous array of values of one variable.
+     * @pre slot is less than getColumnCount().
+     * @post Does not change the columns.
+     * @param slot The variable slot, 0 for a through 5 for f and higher slots for other names.
+     * @return A pointer to getRowCount() values.
+     * @throws PrecondViolatedExcept if slot is not a valid column. */
+    const double* getColumn(std::size_t slot) const;
+
+    /** Removes all rows.
+     * @pre None
+     * @post Every column is empty. */
+    void clear() noexcept;
+}; // end VariableColumns
+
+#include "VariableColumns.cpp"
+#endif
@@ -0,0 +1,80 @@
+/** @file VariableFileLoader.cpp
+ * VariableFileLoader parses memory-mapped rows of variable values into columns with std::from_chars.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "VariableFileLoader.h"
+
+std::vector<VariableFileLoader::RowError> VariableFileLoader::loadFile(const std::string& filename,
+    VariableColumns& columns)
+{
+    MappedFile file(filename);  // Throws if the file cannot be opened
+    return loadBuffer(file.data(), file.size(), columns);
+} // end loadFile
+
+std::vector<VariableFileLoader::RowError> VariableFileLoader::loadBuffer(const char* data, std::size_t size,
+    VariableColumns& columns)
+{
+    std::vector<RowError> errors;
+    if (data == nullptr || size == 0) return errors;
+
+    const char* position = data;
+    const char* bufferEnd = data + size;
+
+    // Reserve one row per line so the columns grow once
+    columns.reserve(columns.getRowCount() + static_cast<std::size_t>(std::count(data, bufferEnd, '\n')) + 1);
+
+    std::vector<double> row(columns.getColumnCount());
+    std::size_t lineNumber = 0;
+
+    while (position < bufferEnd)
+    {
+        ++lineNumber;
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', bufferEnd - position));
+        if (lineEnd == nullptr) lineEnd = bufferEnd;
+
+        std::size_t valueCount = 0;
+        bool rowValid = true;
+
+        while (rowValid)
+        {
+            // Skip the whitespace before the next value
+            while (position < lineEnd && (*position == ' ' || *position == '\t' || *position == '\r')) ++position;
+            if (position == lineEnd) break;
+
+            const char* tokenStart = position;
+            while (position < lineEnd && *position != ' ' && *position != '\t' && *position != '\r') ++position;
+
+            if (valueCount == row.size())
+            {
+                errors.push_back({ lineNumber, "Row contains too many values." });
+                rowValid = false;
+                break;
+            }
+
+            double value = 0;
+            std::from_chars_result parsed = std::from_chars(tokenStart, position, value);
+            if (parsed.ec != std::errc() || parsed.ptr != position)
+            {
+                errors.push_back({ lineNumber, "Invalid value: " + std::string(tokenStart, position) });
+                rowValid = false;
+                break;
+            }
+            row[valueCount++] = value;
+        }
+
+        if (rowValid && valueCount == row.size())
+        {
+            columns.addRow(row.data());
+        }
+        else if (rowValid && valueCount != 0)  // Blank lines are skipped silently
+        {
+            errors.push_back({ lineNumber, "Row does not contain enough values." });
+        }
+
+        position = lineEnd + 1;  // Move past the newline
+    }
+
+    return errors;
+} // end loadBuffer
@@ -0,0 +1,53 @@
+/** @file VariableFileLoader.h
+ * @class VariableFileLoader
+ * Loads many rows of variable values from a whitespace-separated file straight into VariableColumns. The file is
+ * memory-mapped and numbers are parsed with std::from_chars, so no streams or locales are involved. Rows with
+ * errors are skipped and reported, and the rest of the file is still loaded. */
+
+#ifndef VARIABLE_FILE_LOADER_
+#define VARIABLE_FILE_LOADER_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "VariableColumns.h"
+
+class VariableFileLoader
+{
+public:
+    /** Describes a row that could not be loaded. */
+    struct RowError
+    {
+        /** The line number of the row, starting at 1. */
+        std::size_t lineNumber;
+
+        /** Why the row was skipped. */
+        std::string message;
+    };
+
+    /** Loads every row of a file into a set of variable columns.
+     * @pre Each line of the file holds one row of columns.getColumnCount() numbers separated by spaces or tabs.
+     * @post Every valid row is appended to columns in file order. The file is unchanged.
+     * @param filename The name of the file containing variable values.
+     * @param columns The columns that receive the rows.
+     * @return The errors of the rows that were skipped, in file order.
+     * @throws std::runtime_error If the file cannot be opened or mapped. */
+    static std::vector<RowError> loadFile(const std::string& filename, VariableColumns& columns);
+
+    /** Loads every row of an in-memory buffer into a set of variable columns.
+     * @pre Each line of the buffer holds one row of columns.getColumnCount() numbers separated by spaces or tabs.
+     * @post Every valid row is appended to columns in buffer order.
+     * @param data The first character of the buffer.
+     * @param size The number of characters in the buffer.
+     * @param columns The columns that receive the rows.
+     * @return The errors of the rows that were skipped, in buffer order. */
+    static std::vector<RowError> loadBuffer(const char* data, std::size_t size, VariableColumns& columns);
+}; // end VariableFileLoader
+
+#include "VariableFileLoader.cpp"
+#endif
@@ -0,0 +1,160 @@
+/** @file WorkStealingPool.cpp
+ * WorkStealingPool runs indexed tasks on worker threads that steal work from each other when idle.
+ * @author Stephen Wagner
+ * @date 11/5/2024
+ * CSCI 591 Section 1 */
+
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(std::size_t workerCount)
+    : currentTask(nullptr), pendingTasks(0), generation(0), stopping(false)
+{
+    if (workerCount == 0)  // Default to one worker per hardware thread
+    {
+        workerCount = std::thread::hardware_concurrency();
+        if (workerCount == 0) workerCount = 1;
+    }
+
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        workerQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+} // end constructor
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+} // end destructor
+
+std::size_t WorkStealingPool::getWorkerCount() const noexcept
+{
+    return workers.size();
+} // end getWorkerCount
+
+void WorkStealingPool::parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task)
+{
+    if (taskCount == 0) return;
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+    std::size_t workerCount = workerQueues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        taskErrors.assign(taskCount, nullptr);
+
+        // Give each worker a contiguous range of indices so neighbouring tasks stay on one thread
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            std::size_t rangeStart = taskCount * i / workerCount;
+            std::size_t rangeEnd = taskCount * (i + 1) / workerCount;
+            std::lock_guard<std::mutex> queueLock(workerQueues[i]->queueMutex);
+            for (std::size_t index = rangeStart; index < rangeEnd; ++index)
+            {
+                workerQueues[i]->taskIndices.push_back(index);
+            }
+        }
+
+        currentTask = &task;
+        pendingTasks = taskCount;
+        ++generation;
+    }
+    workAvailable.notify_all();
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    workFinished.wait(lock, [this] { return pendingTasks == 0; });
+    currentTask = nullptr;
+
+    // Report the failure of the lowest task index so the result does not depend on scheduling
+    for (std::exception_ptr& error : taskErrors)
+    {
+        if (error) std::rethrow_exception(error);
+    }
+} // end parallelFor
+
+void WorkStealingPool::workerLoop(std::size_t workerIndex)
+{
+    std::size_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        while (runNextTask(workerIndex))
+        {
+        } // Keep working until every queue is empty
+    }
+} // end workerLoop
+
+bool WorkStealingPool::runNextTask(std::size_t workerIndex)
+{
+    std::size_t workerCount = workerQueues.size();
+    std::size_t taskIndex = 0;
+    bool found = false;
+
+    // Take from the front of our own queue first
+    {
+        WorkerQueue& ownQueue = *workerQueues[workerIndex];
+        std::lock_guard<std::mutex> queueLock(ownQueue.queueMutex);
+        if (!ownQueue.taskIndices.empty())
+        {
+            taskIndex = ownQueue.taskIndices.front();
+            ownQueue.taskIndices.pop_front();
+            found = true;
+        }
+    }
+
+    // Otherwise steal from the back of another worker's queue
+    for (std::size_t offset = 1; !found && offset < workerCount; ++offset)
+    {
+        WorkerQueue& victimQueue = *workerQueues[(workerIndex + offset) % workerCount];
+        std::lock_guard<std::mutex> queueLock(victimQueue.queueMutex);
+        if (!victimQueue.taskIndices.empty())
+        {
+            taskIndex = victimQueue.taskIndices.back();
+            victimQueue.taskIndices.pop_back();
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+
+    const std::function<void(std::size_t)>* task;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        task = currentTask;
+    }
+
+    try
+    {
+        (*task)(taskIndex);
+    }
+    catch (...)
+    {
+        taskErrors[taskIndex] = std::current_exception();  // Each task writes only its own slot
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (--pendingTasks == 0)
+    {
+        workFinished.notify_all();
+    }
+    return true;
+} // end runNextTask
@@ -0,0 +1,101 @@
+/** @file WorkStealingPool.h
+ * @class WorkStealingPool
+ * A fixed set of worker threads that run indexed tasks. Each worker owns a queue of task indices, takes work from
+ * the front of its own queue and steals from the back of other workers' queues once its own queue is empty. */
+
+#ifndef WORK_STEALING_POOL_
+#define WORK_STEALING_POOL_
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+class WorkStealingPool
+{
+private:
+    /** Task indices owned by one worker, guarded by their own mutex so stealing does not block other workers. */
+    struct WorkerQueue
+    {
+        std::mutex queueMutex;
+        std::deque<std::size_t> taskIndices;
+    };
+
+    /** Worker threads. */
+    std::vector<std::thread> workers;
+
+    /** One task queue per worker. */
+    std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+
+    /** Serializes calls to parallelFor so only one set of tasks runs at a time. */
+    std::mutex runMutex;
+
+    /** Guards the fields below and backs both condition variables. */
+    std::mutex stateMutex;
+
+    /** Signaled when a new set of tasks is available or the pool is stopping. */
+    std::condition_variable workAvailable;
+
+    /** Signaled when the last task of a set finishes. */
+    std::condition_variable workFinished;
+
+    /** The task function of the current set. */
+    const std::function<void(std::size_t)>* currentTask;
+
+    /** Number of tasks of the current set that have not finished. */
+    std::size_t pendingTasks;
+
+    /** Incremented for every new set of tasks so sleeping workers can tell it apart from the last one. */
+    std::size_t generation;
+
+    /** Set when the pool is being destroyed. */
+    bool stopping;
+
+    /** Exception thrown by each task of the current set, if any, indexed by task. */
+    std::vector<std::exception_ptr> taskErrors;
+
+    /** Main loop of a worker thread.
+     * @param workerIndex The index of the worker's own queue. */
+    void workerLoop(std::size_t workerIndex);
+
+    /** Takes one task from the worker's own queue or steals one from another worker and runs it.
+     * @param workerIndex The index of the worker's own queue.
+     * @return True if a task was run, false if every queue was empty. */
+    bool runNextTask(std::size_t workerIndex);
+
+public:
+    /** Creates a pool and starts its worker threads.
+     * @param workerCount The number of worker threads. 0 uses one worker per hardware thread. */
+    explicit WorkStealingPool(std::size_t workerCount = 0);
+
+    /** Copying a pool of running threads is not supported. */
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /** Destructor. Stops and joins all worker threads. */
+    virtual ~WorkStealingPool();
+
+    /** Gets the number of worker threads.
+     * @pre None
+     * @post None
+     * @return The number of worker threads. */
+    std::size_t getWorkerCount() const noexcept;
+
+    /** Runs task(0) through task(taskCount - 1) on the worker threads and waits for all of them to finish.
+     * Indices are split into contiguous ranges, one per worker, and idle workers steal from busy ones.
+     * @pre task is safe to call concurrently for different indices.
+     * @post Every task has run exactly once.
+     * @param taskCount The number of tasks.
+     * @param task The function to run for each task index.
+     * @throws Rethrows the exception of the lowest-indexed task that threw, so failures are reported the same way
+     * regardless of scheduling. */
+    void parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task);
+}; // end WorkStealingPool
+
+#include "WorkStealingPool.cpp"
+#endif